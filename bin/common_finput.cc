@@ -24,6 +24,7 @@
 #include <fstream>
 #include <cstring>
 #include <unistd.h>
+#include <spot/tl/binary.hh>
 
 enum {
   OPT_LBT = 1,
@@ -41,7 +42,8 @@ static const argp_option options[] =
     { "file", 'F', "FILENAME[/COL]", 0,
       "process each line of FILENAME as a formula; if COL is a "
       "positive integer, assume a CSV file and read column COL; use "
-      "a negative COL to drop the first line of the CSV file", 0 },
+      "a negative COL to drop the first line of the CSV file; files "
+      "output with --binary are also accepted", 0 },
     { "lbt-input", OPT_LBT, nullptr, 0,
       "read all formulas using LBT's prefix syntax", 0 },
     { "lenient", OPT_LENIENT, nullptr, 0,
@@ -138,6 +140,32 @@ job_processor::process_stream(std::istream& is,
   int linenum = 1;
   std::string line;
 
+  // Formulas output with --binary need no parsing.
+  if (spot::binary_formula_reader::is_binary(is))
+    {
+      if (col_to_read != 0)
+        error_at_line(2, 0, filename, linenum,
+                      "cannot read a column of a binary formula stream");
+      spot::binary_formula_reader reader(is);
+      // Formulas are numbered as if they were on separate lines.
+      while (!abort_run)
+        {
+          spot::formula f;
+          try
+            {
+              f = reader.next();
+            }
+          catch (const std::runtime_error& e)
+            {
+              error_at_line(2, 0, filename, linenum, "%s", e.what());
+            }
+          if (!f)
+            break;
+          error |= process_formula(f, filename, linenum++);
+        }
+      return error;
+    }
+
   // Discard the first line of a CSV file if requested.
   if (col_to_read < 0)
     {
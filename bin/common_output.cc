@@ -23,6 +23,7 @@
 #include "common_setup.hh"
 #include <iostream>
 #include <sstream>
+#include <spot/tl/binary.hh>
 #include <spot/tl/print.hh>
 #include <spot/tl/length.hh>
 #include <spot/tl/apcollect.hh>
@@ -33,7 +34,8 @@
 #include "error.h"
 
 enum {
-  OPT_CSV = 1,
+  OPT_BINARY = 1,
+  OPT_CSV,
   OPT_FORMAT,
   OPT_LATEX,
   OPT_SPOT,
@@ -55,6 +57,9 @@ static const argp_option options[] =
     { "wring", OPT_WRING, nullptr, 0, "output in Wring's syntax", -20 },
     { "utf8", '8', nullptr, 0, "output using UTF-8 characters", -20 },
     { "latex", OPT_LATEX, nullptr, 0, "output using LaTeX macros", -20 },
+    { "binary", OPT_BINARY, nullptr, 0,
+      "output in Spot's binary formula stream format, which all tools "
+      "can read back without parsing (incompatible with --format)", -20 },
     // --csv-escape was deprecated in Spot 2.1, we can remove it at
     // some point
     { "csv-escape", OPT_CSV, nullptr, OPTION_HIDDEN,
@@ -104,6 +109,7 @@ stream_formula(std::ostream& out,
         report_not_ltl(f, filename, linenum, "LBT");
       break;
     case spot_output:
+    case binary_output:         // e.g., for %f in --output
       spot::print_psl(out, f, full_parenth);
       break;
     case spin_output:
@@ -301,6 +307,12 @@ static formula_printer* format = nullptr;
 static std::ostringstream outputname;
 static formula_printer* outputnamer = nullptr;
 static std::map<std::string, std::unique_ptr<output_file>> outputfiles;
+static std::map<std::ostream*,
+                std::unique_ptr<spot::binary_formula_writer>> binwriters;
+// Formulas printed without --format go through one buffer per output
+// stream, that remembers how atomic propositions are printed.
+static std::map<std::ostream*,
+                std::unique_ptr<spot::formula_print_buffer>> printbufs;
 
 int
 parse_opt_output(int key, char* arg, struct argp_state*)
@@ -328,6 +340,9 @@ parse_opt_output(int key, char* arg, struct argp_state*)
     case 's':
       output_format = spin_output;
       break;
+    case OPT_BINARY:
+      output_format = binary_output;
+      break;
     case OPT_CSV:
       escape_csv = true;
       break;
@@ -344,6 +359,10 @@ parse_opt_output(int key, char* arg, struct argp_state*)
       delete format;
       format = new formula_printer(std::cout, arg);
       break;
+    case ARGP_KEY_END:
+      if (output_format == binary_output && format)
+        error(2, 0, "options --binary and --format are incompatible");
+      break;
     default:
       return ARGP_ERR_UNKNOWN;
     }
@@ -352,6 +371,51 @@ parse_opt_output(int key, char* arg, struct argp_state*)
 }
 
 
+// Print f followed by the output terminator.  The buffer is drained
+// after each formula because other output (e.g., lines kept by
+// --skip-errors) may be written to the same stream.
+static void
+output_plain_formula(std::ostream& out, spot::formula f,
+                     const char* filename, const char* linenum)
+{
+  typedef spot::formula_print_buffer pb;
+  pb::style style = pb::psl;
+  const char* syn = nullptr;
+  switch (output_format)
+    {
+    case lbt_output:
+      style = pb::lbt_ltl;
+      syn = "LBT";
+      break;
+    case spot_output:
+    case binary_output:
+    case count_output:
+    case quiet_output:
+      break;
+    case spin_output:
+      style = pb::spin_ltl;
+      syn = "Spin";
+      break;
+    case wring_output:
+      style = pb::wring_ltl;
+      syn = "Wring";
+      break;
+    case utf8_output:
+      style = pb::utf8_psl;
+      break;
+    case latex_output:
+      style = pb::latex_psl;
+      break;
+    }
+  if (syn && !f.is_ltl_formula())
+    report_not_ltl(f, filename, linenum, syn);
+  auto& buf = printbufs[&out];
+  if (!buf)
+    buf.reset(new pb(out, style, full_parenth));
+  *buf << f << output_terminator;
+  buf->flush();
+}
+
 static void
 output_formula(std::ostream& out,
                spot::formula f, spot::process_timer* ptimer,
@@ -422,8 +486,23 @@ output_formula_checked(spot::formula f, spot::process_timer* ptimer,
         p.first->second.reset(new output_file(fname.c_str()));
       out = &p.first->second->ostream();
     }
-  output_formula(*out, f, ptimer, filename, linenum, prefix, suffix);
-  *out << output_terminator;
+  if (output_format == binary_output)
+    {
+      // Each output stream has its own table of subformulas.
+      auto& w = binwriters[out];
+      if (!w)
+        w.reset(new spot::binary_formula_writer(*out));
+      w->write(f);
+      check_cout();
+      return;
+    }
+  if (!format && !prefix && !suffix && !escape_csv)
+    output_plain_formula(*out, f, filename, linenum);
+  else
+    {
+      output_formula(*out, f, ptimer, filename, linenum, prefix, suffix);
+      *out << output_terminator;
+    }
   // Make sure we abort if we can't write to std::cout anymore
   // (like disk full or broken pipe with SIGPIPE ignored).
   check_cout();
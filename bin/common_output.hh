@@ -32,7 +32,7 @@
 
 enum output_format_t { spot_output, spin_output, utf8_output,
                        lbt_output, wring_output, latex_output,
-                       quiet_output, count_output };
+                       quiet_output, count_output, binary_output };
 extern output_format_t output_format;
 extern bool full_parenth;
 extern bool escape_csv;
@@ -19,7 +19,9 @@
 
 #include "common_trans.hh"
 #include "common_setup.hh"
+#include <algorithm>
 #include <cstring>
+#include <ctime>
 #include <cstdlib>
 #include <cassert>
 #include <unistd.h>
@@ -465,13 +467,52 @@ static unsigned timeout = 0;
 static std::atomic<int> alarm_on{0};
 static int child_pid = -1;
 
+// Children started by spawn_child().  This vector is only modified
+// while the signals handled by sig_handler() are blocked.
+struct running_child
+{
+  int pid;
+  time_t deadline;              // 0 if there is no timeout
+  int kills;                    // signals sent after the deadline
+  bool canceled;                // killed by kill_child()
+};
+static std::vector<running_child> running_children;
+
+// Kill the children whose deadline is reached, and schedule the
+// next alarm.  The first two signals are SIGTERM, the next ones are
+// SIGKILL, and they are sent two seconds apart.
+static void
+check_children_deadlines()
+{
+  time_t now = time(nullptr);
+  time_t next = 0;
+  for (auto& c: running_children)
+    {
+      if (!c.deadline)
+        continue;
+      if (c.deadline <= now)
+        {
+          kill(-c.pid, c.kills++ < 2 ? SIGTERM : SIGKILL);
+          c.deadline = now + 2;
+        }
+      if (!next || c.deadline < next)
+        next = c.deadline;
+    }
+  if (next)
+    alarm(std::max<time_t>(next - now, 1));
+}
+
 static void
 sig_handler(int sig)
 {
   if (child_pid == 0)
     error(2, 0, "received signal %d before starting child", sig);
 
-  if (sig == SIGALRM && alarm_on)
+  if (sig == SIGALRM && !alarm_on)
+    {
+      check_children_deadlines();
+    }
+  else if (sig == SIGALRM)
     {
       timed_out = true;
       if (--alarm_on)
@@ -491,7 +532,10 @@ sig_handler(int sig)
   else
     {
       // forward signal
-      kill(-child_pid, sig);
+      if (child_pid > 0)
+        kill(-child_pid, sig);
+      for (auto& c: running_children)
+        kill(-c.pid, sig);
       // cleanup files
       spot::cleanup_tmpfiles();
       // and die verbosely
@@ -751,13 +795,12 @@ exec_command(const char* cmd)
 extern char **environ;
 #endif
 
-int
-exec_with_timeout(const char* cmd)
+// Start CMD in its own process group.  If CHILD_MASK is given, it
+// is used as the signal mask of the child, instead of ours.
+static int
+spawn_command_masked(const char* cmd, const sigset_t* child_mask)
 {
-  int status;
-
-  timed_out = false;
-
+  pid_t pid;
 #ifdef HAVE_SPAWN_H
   simple_command res = parse_simple_command(cmd);
 
@@ -770,7 +813,14 @@ exec_with_timeout(const char* cmd)
     error(2, err, "posix_spawnattr_init() failed");
   if (int err = posix_spawnattr_setpgroup(&attr, 0))
     error(2, err, "posix_spawnattr_setpgroup() failed");
-  if (int err = posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP))
+  short flags = POSIX_SPAWN_SETPGROUP;
+  if (child_mask)
+    {
+      if (int err = posix_spawnattr_setsigmask(&attr, child_mask))
+        error(2, err, "posix_spawnattr_setsigmask() failed");
+      flags |= POSIX_SPAWN_SETSIGMASK;
+    }
+  if (int err = posix_spawnattr_setflags(&attr, flags))
     error(2, err, "posix_spawnattr_setflags() failed");
   posix_spawn_file_actions_t actions;
   if (int err = posix_spawn_file_actions_init(&actions))
@@ -794,7 +844,7 @@ exec_with_timeout(const char* cmd)
                                                        O_CREAT | O_WRONLY |
                                                        O_TRUNC, 0644))
           error(2, err, "posix_spawn_file_actions_addopen() failed");
-      if (int err = posix_spawnp(&child_pid, res.args[0], &actions, &attr,
+      if (int err = posix_spawnp(&pid, res.args[0], &actions, &attr,
                                  res.args.data(), environ))
         error(2, err, "failed to run '%s'", res.args[0]);
     }
@@ -806,14 +856,14 @@ exec_with_timeout(const char* cmd)
       if (has_bin_sh)
         {
           const char* args[] = { "/bin/sh", "-c", cmd, nullptr };
-          if (posix_spawn(&child_pid, args[0], &actions, &attr,
+          if (posix_spawn(&pid, args[0], &actions, &attr,
                           const_cast<char **>(args), environ))
             has_bin_sh = false;
         }
       if (!has_bin_sh)
         {
           const char* args[] = { "sh", "-c", cmd, nullptr };
-          if (int err = posix_spawnp(&child_pid, args[0], &actions, &attr,
+          if (int err = posix_spawnp(&pid, args[0], &actions, &attr,
                                      const_cast<char **>(args), environ))
             error(2, err, "failed to run '%s' via 'sh'", cmd);
         }
@@ -823,13 +873,15 @@ exec_with_timeout(const char* cmd)
   if (int err = posix_spawnattr_destroy(&attr))
     error(2, err, "posix_spawnattr_destroy() failed");
 #else
-  child_pid = fork();
-  if (child_pid == -1)
+  pid = fork();
+  if (pid == -1)
     error(2, errno, "failed to fork()");
 
-  if (child_pid == 0)
+  if (pid == 0)
     {
       setpgid(0, 0);
+      if (child_mask)
+        sigprocmask(SIG_SETMASK, child_mask, nullptr);
       // Close stdin so that children may not read our input.  We had
       // this nice surprise with Seminator, who greedily consumes its
       // stdin (which was also ours) even if it does not use it
@@ -840,6 +892,23 @@ exec_with_timeout(const char* cmd)
       return -1;
     }
 #endif
+  return pid;
+}
+
+int
+spawn_command(const char* cmd)
+{
+  return spawn_command_masked(cmd, nullptr);
+}
+
+int
+exec_with_timeout(const char* cmd)
+{
+  int status;
+
+  timed_out = false;
+
+  child_pid = spawn_command(cmd);
   alarm(timeout);
   // Upon SIGALRM, the child will receive up to 3
   // signals: SIGTERM, SIGTERM, SIGKILL.
@@ -853,6 +922,87 @@ exec_with_timeout(const char* cmd)
   alarm(0);
   return status;
 }
+
+// Block the signals handled by sig_handler(), and save the previous
+// signal mask in OLD.
+static void
+block_handled_signals(sigset_t& old)
+{
+  sigset_t ss;
+  sigemptyset(&ss);
+  sigaddset(&ss, SIGALRM);
+  sigaddset(&ss, SIGHUP);
+  sigaddset(&ss, SIGINT);
+  sigaddset(&ss, SIGQUIT);
+  sigaddset(&ss, SIGTERM);
+  sigprocmask(SIG_BLOCK, &ss, &old);
+}
+
+int
+spawn_child(const char* cmd, unsigned timeout)
+{
+  // Keep the signals blocked until the child is registered, so that
+  // a termination signal cannot leave an unknown child running.  The
+  // child itself starts with our original mask.
+  sigset_t old;
+  block_handled_signals(old);
+  int pid = spawn_command_masked(cmd, &old);
+  running_children.push_back({pid,
+                              timeout ? time(nullptr) + timeout : 0, 0,
+                              false});
+  if (timeout)
+    check_children_deadlines();
+  sigprocmask(SIG_SETMASK, &old, nullptr);
+  return pid;
+}
+
+int
+wait_child(int& status, bool& timed_out)
+{
+  for (;;)
+    {
+      int pid = waitpid(-1, &status, 0);
+      if (pid == -1)
+        error(2, errno, "error during wait()");
+      sigset_t old;
+      block_handled_signals(old);
+      auto it = std::find_if(running_children.begin(),
+                             running_children.end(),
+                             [pid](const running_child& c)
+                             {
+                               return c.pid == pid;
+                             });
+      bool found = it != running_children.end();
+      if (found)
+        {
+          timed_out = it->kills > 0 && !it->canceled;
+          running_children.erase(it);
+          if (running_children.empty())
+            alarm(0);
+        }
+      sigprocmask(SIG_SETMASK, &old, nullptr);
+      if (found)
+        return pid;
+    }
+}
+
+void
+kill_child(int pid)
+{
+  sigset_t old;
+  block_handled_signals(old);
+  for (auto& c: running_children)
+    if (c.pid == pid && !c.canceled)
+      {
+        // Send SIGTERM now, and let check_children_deadlines()
+        // escalate to SIGKILL if the child does not terminate.
+        c.canceled = true;
+        c.deadline = time(nullptr);
+        check_children_deadlines();
+        break;
+      }
+  sigprocmask(SIG_SETMASK, &old, nullptr);
+}
 #endif // ENABLE_TIMEOUT
 
 enum {
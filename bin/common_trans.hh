@@ -170,7 +170,23 @@ extern std::atomic<bool> timed_out;
 extern unsigned timeout_count;
 #if ENABLE_TIMEOUT
 void setup_sig_handler();
+// Start CMD in a new process group, and return its pid without
+// waiting for it.
+int spawn_command(const char* cmd);
 int exec_with_timeout(const char* cmd);
+// Start CMD like spawn_command(), for running several commands in
+// parallel.  The process group of CMD is killed after TIMEOUT
+// seconds (unless TIMEOUT is 0), or when a termination signal is
+// caught by the handler installed with setup_sig_handler().
+int spawn_child(const char* cmd, unsigned timeout);
+// Wait for one of the children started with spawn_child(), and
+// return its pid.  TIMED_OUT is set if it had to be killed because
+// of its timeout.
+int wait_child(int& status, bool& timed_out);
+// Send SIGTERM to the process group of a child started with
+// spawn_child(), followed by SIGKILL if it is still running a few
+// seconds later.  The child must still be waited for.
+void kill_child(int pid);
 #else // !ENABLE_TIMEOUT
 #define exec_with_timeout(cmd) system(cmd)
 #define setup_sig_handler() while (0);
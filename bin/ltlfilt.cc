@@ -712,18 +712,49 @@ namespace
       matched &= !opt->imply || simpl.implication(f, opt->imply);
       matched &= !opt->equivalent_to
         || simpl.are_equivalent(f, opt->equivalent_to);
-      matched &= !stutter_insensitive || spot::is_stutter_invariant(f);
 
-      if (matched && (obligation || recurrence || persistence
-                      || !opt->acc_words.empty()
-                      || !opt->rej_words.empty()
-                      || liveness))
+      // The semantic checks below share the automata for f and !f,
+      // that are translated at most once.
+      spot::twa_graph_ptr aut = nullptr;
+      spot::twa_graph_ptr neg_aut = nullptr;
+      auto get_aut = [&]()
         {
-          spot::twa_graph_ptr aut = nullptr;
+          if (!aut)
+            aut = ltl_to_tgba_fm(f, simpl.get_dict(), true);
+          return aut;
+        };
+      auto get_neg_aut = [&]()
+        {
+          if (!neg_aut)
+            neg_aut = ltl_to_tgba_fm(spot::formula::Not(f),
+                                     simpl.get_dict(), true);
+          return neg_aut;
+        };
+
+      bool need_aut = (obligation || recurrence || persistence
+                       || !opt->acc_words.empty()
+                       || !opt->rej_words.empty()
+                       || liveness);
+
+      // Only feed the shared automata to the stutter check if some
+      // other filter needs them as well.  Otherwise, let
+      // is_stutter_invariant() pick its own (usually cheaper) method
+      // according to SPOT_STUTTER_CHECK.
+      if (matched && stutter_insensitive)
+        {
+          if (need_aut
+              && !(f.is_ltl_formula() && f.is_syntactic_stutter_invariant()))
+            matched = spot::is_stutter_invariant(f, get_aut(),
+                                                 get_neg_aut());
+          else
+            matched = spot::is_stutter_invariant(f);
+        }
 
+      if (matched && need_aut)
+        {
           if (!opt->acc_words.empty() || !opt->rej_words.empty() || liveness)
             {
-              aut = ltl_to_tgba_fm(f, simpl.get_dict(), true);
+              get_aut();
 
               if (matched && !opt->acc_words.empty())
                 for (auto& word_aut: opt->acc_words)
@@ -766,10 +797,7 @@ namespace
               // other reasons.
               if (obligation && (safety || guarantee))
                 {
-                  if (!aut)
-                    aut = ltl_to_tgba_fm(f, simpl.get_dict(), true);
-
-                  auto min = minimize_obligation(aut, f);
+                  auto min = minimize_obligation(get_aut(), f, neg_aut);
                   assert(min);
                   if (aut == min)
                     {
@@ -785,11 +813,16 @@ namespace
                     }
                 }
               else if (obligation) // just obligation, not safety or guarantee
-                  matched &= is_obligation(f, aut);
+                matched &= is_obligation(f, get_aut(), spot::ocheck::Auto,
+                                         neg_aut);
               else if (persistence)
-                matched &= spot::is_persistence(f);
+                matched &= spot::is_persistence(f, get_aut(),
+                                                spot::prcheck::Auto,
+                                                get_neg_aut());
               else if (recurrence)
-                matched &= spot::is_recurrence(f, aut);
+                matched &= spot::is_recurrence(f, get_aut(),
+                                               spot::prcheck::Auto,
+                                               get_neg_aut());
             }
         }
 
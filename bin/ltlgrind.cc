@@ -20,6 +20,13 @@
 
 #include "common_sys.hh"
 #include <argp.h>
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+#include <cassert>
+#include <iostream>
+#include <sys/wait.h>
 #include "error.h"
 
 #include "common_setup.hh"
@@ -27,11 +34,14 @@
 #include "common_output.hh"
 #include "common_conv.hh"
 #include "common_cout.hh"
+#include "common_trans.hh"
 
 #include <spot/tl/mutation.hh>
+#include <spot/tl/print.hh>
 
 enum {
   OPT_AP2CONST = 1,
+  OPT_MINIMIZE,
   OPT_SIMPLIFY_BOUNDS,
   OPT_REMOVE_MULTOP_OPERANDS,
   OPT_REMOVE_OPS,
@@ -47,6 +57,9 @@ static unsigned max_output = -1U;
 static unsigned opt_all = spot::Mut_All;
 static unsigned mut_opts = 0;
 static bool opt_sort = false;
+static const char* opt_minimize = nullptr;
+static unsigned opt_jobs = 1;
+static unsigned opt_timeout = 0;
 
 static const char * argp_program_doc =
   "List formulas that are similar to but simpler than a given formula.";
@@ -76,6 +89,18 @@ static const argp_option options[] = {
     "on a bounded unary operator, decrement one of the bounds, or set min to "
     "0 or max to unbounded", 15 },
     /**************************************************/
+  { nullptr, 0, nullptr, 0, "Minimization:", 16 },
+  { "minimize", OPT_MINIMIZE, "COMMANDFMT", 0,
+    "instead of listing the mutations of each formula, repeatedly "
+    "replace the formula by its smallest mutation for which COMMANDFMT "
+    "succeeds (e.g., a command that reproduces a bug), and output "
+    "the final formula; %f,%s,%l,%w are replaced by the formula as a "
+    "quoted string in Spot, Spin, LBT, or Wring's syntax", 0 },
+  { "jobs", 'j', "NUM", 0, "run up to NUM commands in parallel with "
+    "--minimize (default: 1); the result does not depend on NUM", 0 },
+  { "timeout", 'T', "NUMBER", 0, "kill commands run by --minimize after "
+    "NUMBER seconds; a command that is killed counts as a failure", 0 },
+    /**************************************************/
   { nullptr, 0, nullptr, 0, "Output options:", -20 },
   { "max-count", 'n', "NUM", 0, "maximum number of mutations to output", 0 },
   { "mutations", 'm', "NUM", 0, "number of mutations to apply to the "
@@ -112,13 +137,121 @@ static const argp_child children[] = {
 
 namespace
 {
+  class check_runner final: protected spot::formater
+  {
+    quoted_formula ltl_formula;
+  public:
+    check_runner()
+    {
+      declare('f', &ltl_formula);
+      declare('s', &ltl_formula);
+      declare('l', &ltl_formula);
+      declare('w', &ltl_formula);
+    }
+
+    std::string
+    command(spot::formula f)
+    {
+      ltl_formula = f;
+      std::ostringstream cmd;
+      format(cmd, opt_minimize);
+      return cmd.str();
+    }
+
+    // Return the index of the first formula of fs for which the
+    // command succeeds, or fs.size() if there is none.  Up to
+    // opt_jobs commands are run in parallel, and the commands for
+    // formulas that come after a successful one are canceled.
+    unsigned
+    first_success(const std::vector<spot::formula>& fs)
+    {
+      unsigned n = fs.size();
+      unsigned best = n;
+#if ENABLE_TIMEOUT
+      std::map<int, unsigned> running; // pid -> index in fs
+      unsigned next = 0;
+      for (;;)
+        {
+          while (next < best && running.size() < opt_jobs)
+            {
+              int pid = spawn_child(command(fs[next]).c_str(), opt_timeout);
+              running.emplace(pid, next++);
+            }
+          if (running.empty())
+            break;
+          int status;
+          bool timed_out;
+          int pid = wait_child(status, timed_out);
+          auto it = running.find(pid);
+          assert(it != running.end());
+          unsigned i = it->second;
+          running.erase(it);
+          if (i < best && !timed_out
+              && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            {
+              best = i;
+              for (auto& p: running)
+                if (p.second > best)
+                  kill_child(p.first);
+            }
+        }
+#else
+      for (unsigned i = 0; i < n; ++i)
+        {
+          int status = system(command(fs[i]).c_str());
+          if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            {
+              best = i;
+              break;
+            }
+        }
+#endif
+      return best;
+    }
+  };
+
   class mutate_processor final: public job_processor
   {
+    check_runner runner;
   public:
     int
     process_formula(spot::formula f, const char* filename = nullptr,
                     int linenum = 0) override
     {
+      if (opt_minimize)
+        {
+          if (runner.first_success({f}) != 0)
+            {
+              std::string fs = spot::str_psl(f);
+              const char* msg = "'%s' does not satisfy --minimize";
+              if (filename)
+                error_at_line(0, 0, filename, linenum, msg, fs.c_str());
+              else
+                error(0, 0, msg, fs.c_str());
+              return 1;
+            }
+          // Mutations already tried, in this round or in a previous
+          // one, need not be checked again.
+          std::unordered_set<spot::formula> seen{f};
+          for (;;)
+            {
+              auto mutations =
+                spot::mutate(f, mut_opts, max_output, mutation_nb, true);
+              mutations.erase(std::remove_if(mutations.begin(),
+                                             mutations.end(),
+                                             [&](spot::formula g)
+                                             {
+                                               return !seen.insert(g).second;
+                                             }), mutations.end());
+              unsigned i = runner.first_success(mutations);
+              if (i == mutations.size())
+                break;
+              f = mutations[i];
+            }
+          output_formula_checked(f, nullptr, filename, linenum,
+                                 prefix, suffix);
+          return 0;
+        }
       auto mutations =
         spot::mutate(f, mut_opts, max_output, mutation_nb, opt_sort);
       for (auto g: mutations)
@@ -135,6 +268,16 @@ parse_opt(int key, char* arg, struct argp_state*)
   BEGIN_EXCEPTION_PROTECT;
   switch (key)
     {
+    case 'j':
+      opt_jobs = to_pos_int(arg, "-j/--jobs");
+      break;
+    case 'T':
+      opt_timeout = to_pos_int(arg, "-T/--timeout");
+#if !ENABLE_TIMEOUT
+      std::cerr << "warning: setting a timeout is not supported "
+                << "on your platform" << std::endl;
+#endif
+      break;
     case 'm':
       mutation_nb = to_unsigned(arg, "-m/--mutations");
       break;
@@ -149,6 +292,9 @@ parse_opt(int key, char* arg, struct argp_state*)
       opt_all = 0;
       mut_opts |= spot::Mut_Ap2Const;
       break;
+    case OPT_MINIMIZE:
+      opt_minimize = arg;
+      break;
     case OPT_REMOVE_ONE_AP:
       opt_all = 0;
       mut_opts |= spot::Mut_Remove_One_Ap;
@@ -197,6 +343,9 @@ main(int argc, char* argv[])
 
       check_no_formula();
 
+      if (opt_minimize)
+        setup_sig_handler();
+
       mutate_processor processor;
       if (processor.run())
         return 2;
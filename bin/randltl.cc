@@ -23,6 +23,7 @@
 #include <fstream>
 #include <argp.h>
 #include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include "error.h"
 
@@ -34,6 +35,15 @@
 #include "common_cout.hh"
 
 #include <sstream>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include <cerrno>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <spot/tl/binary.hh>
 #include <spot/tl/defaultenv.hh>
 #include <spot/tl/randomltl.hh>
 #include <spot/tl/simplify.hh>
@@ -70,6 +80,7 @@ enum {
   OPT_SERE_PRIORITIES,
   OPT_TREE_SIZE,
   OPT_WF,
+  OPT_WORKER,
 };
 
 static const argp_option options[] =
@@ -94,6 +105,18 @@ static const argp_option options[] =
       "trivial simplifications (15)", 0 },
     { "allow-dups", OPT_DUPS, nullptr, 0,
       "allow duplicate formulas to be output", 0 },
+    { "worker", OPT_WORKER, "I/N", 0,
+      "generate only the formulas whose serial number is I+1 modulo N "
+      "(with 0<=I<N), using a random stream derived from the seed and I; "
+      "N processes running with the same options and different I "
+      "generate the -n formulas in parallel, and duplicates are only "
+      "removed within each process", 0 },
+    { "jobs", 'j', "N", 0,
+      "generate the formulas with N processes behaving as --worker=I/N, "
+      "and output them ordered by serial number; unless --allow-dups "
+      "is given, a formula that duplicates an earlier one is replaced "
+      "by the next formula of the same process, so the output depends "
+      "on N", 0 },
     DECLARE_OPT_R,
     RANGE_DOC,
     LEVEL_DOC(3),
@@ -155,6 +178,9 @@ static range opt_tree_size = { 15, 15 };
 static bool opt_unique = true;
 static bool opt_wf = false;
 static bool ap_count_given = false;
+static unsigned opt_worker = 0;
+static unsigned opt_workers = 1;
+static unsigned opt_jobs = 1;
 
 static int
 parse_opt(int key, char* arg, struct argp_state* as)
@@ -167,6 +193,9 @@ parse_opt(int key, char* arg, struct argp_state* as)
     case 'B':
       output = spot::randltlgenerator::Bool;
       break;
+    case 'j':
+      opt_jobs = to_pos_int(arg, "-j/--jobs");
+      break;
     case 'L':
       output = spot::randltlgenerator::LTL;
       break;
@@ -209,6 +238,19 @@ parse_opt(int key, char* arg, struct argp_state* as)
     case OPT_WF:
       opt_wf = true;
       break;
+    case OPT_WORKER:
+      {
+        char* slash = strchr(arg, '/');
+        if (!slash)
+          error(2, 0, "--worker expects an argument of the form I/N");
+        *slash = 0;
+        opt_worker = to_unsigned(arg, "--worker");
+        opt_workers = to_pos_int(slash + 1, "--worker");
+        *slash = '/';
+        if (opt_worker >= opt_workers)
+          error(2, 0, "--worker=I/N requires I<N");
+        break;
+      }
     case ARGP_KEY_ARG:
       // If this is the unique non-option argument, it can
       // be a number of atomic propositions to build.
@@ -237,6 +279,179 @@ parse_opt(int key, char* arg, struct argp_state* as)
   return 0;
 }
 
+static spot::option_map
+generator_options(int seed)
+{
+  spot::option_map opts;
+  opts.set("output", output);
+  opts.set("tree_size_min", opt_tree_size.min);
+  opts.set("tree_size_max", opt_tree_size.max);
+  opts.set("wf", opt_wf);
+  opts.set("seed", seed);
+  opts.set("simplification_level", simplification_level);
+  opts.set("unique", opt_unique);
+  return opts;
+}
+
+// Generate N formulas, or an unbounded number if N is negative, for
+// worker opt_worker out of opt_workers, and pass each of them to OUT
+// with its serial number.
+static void
+generate(int n, const std::function<void(spot::formula, int)>& out)
+{
+  // Each worker uses its own random stream.  The default (single
+  // worker) uses the seed as-is, for compatibility.
+  int seed = opt_seed;
+  if (opt_workers > 1)
+    seed = spot::derive_seed(opt_seed, opt_worker);
+  spot::srand(seed);
+
+  spot::randltlgenerator rg(opt->aprops, generator_options(seed),
+                            opt_pL, opt_pS, opt_pB);
+
+  // The formulas of this worker are numbered opt_worker+1,
+  // opt_worker+1+opt_workers, etc.
+  int count = opt_worker + 1;
+  while (n < 0 || n--)
+    {
+      spot::formula f = rg.next();
+      if (!f)
+        error(2, 0, "failed to generate a new unique formula after %d " \
+              "trials", spot::randltlgenerator::MAX_TRIALS);
+      out(f, count);
+      count += opt_workers;
+    }
+}
+
+namespace
+{
+  // Read the binary formula stream sent by a worker through a pipe.
+  class worker_streambuf final: public std::streambuf
+  {
+  public:
+    explicit worker_streambuf(int fd)
+      : fd_(fd)
+    {
+    }
+
+  protected:
+    int_type underflow() override
+    {
+      ssize_t n;
+      while ((n = read(fd_, buf_, sizeof buf_)) < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return traits_type::eof();
+      setg(buf_, buf_, buf_ + n);
+      return traits_type::to_int_type(*gptr());
+    }
+
+  private:
+    int fd_;
+    char buf_[4096];
+  };
+
+  struct worker
+  {
+    pid_t pid;
+    int fd;
+    worker_streambuf buf;
+    std::istream is;
+    spot::binary_formula_reader reader;
+
+    worker(pid_t pid, int fd)
+      : pid(pid), fd(fd), buf(fd), is(&buf), reader(is)
+    {
+    }
+  };
+}
+
+// Run opt_jobs workers that generate formulas without end, and
+// output the formula numbered K using the next formula of worker
+// (K-1) mod opt_jobs that has not been output yet.  The workers send
+// their formulas in the binary stream format, so nothing is parsed,
+// and they block once their pipe is full.
+static void
+generate_in_parallel()
+{
+  // Do not let the workers output what is buffered.
+  std::cout.flush();
+  fflush(nullptr);
+
+  opt_workers = opt_jobs;
+  std::vector<std::unique_ptr<worker>> workers;
+  for (unsigned i = 0; i < opt_jobs; ++i)
+    {
+      int fds[2];
+      if (pipe(fds))
+        error(2, errno, "pipe() failed");
+      pid_t pid = fork();
+      if (pid < 0)
+        error(2, errno, "fork() failed");
+      if (pid == 0)
+        {
+          close(fds[0]);
+          for (auto& w: workers)
+            close(w->fd);
+          opt_worker = i;
+          std::ostringstream os;
+          spot::binary_formula_writer writer(os);
+          generate(-1, [&](spot::formula f, int)
+                   {
+                     writer.write(f);
+                     std::string s = os.str();
+                     os.str("");
+                     const char* p = s.data();
+                     size_t left = s.size();
+                     while (left)
+                       {
+                         ssize_t w = write(fds[1], p, left);
+                         if (w < 0 && errno == EINTR)
+                           continue;
+                         // The parent does not need more formulas.
+                         if (w <= 0)
+                           _exit(0);
+                         p += w;
+                         left -= w;
+                       }
+                   });
+          _exit(0);
+        }
+      close(fds[1]);
+      workers.emplace_back(new worker(pid, fds[0]));
+    }
+
+  std::unordered_set<spot::formula> seen;
+  for (int count = 1; opt_formulas < 0 || count <= opt_formulas; ++count)
+    {
+      unsigned i = (count - 1) % opt_jobs;
+      spot::formula f;
+      do
+        {
+          try
+            {
+              f = workers[i]->reader.next();
+            }
+          catch (const std::runtime_error& e)
+            {
+              error(2, 0, "worker %u: %s", i, e.what());
+            }
+          if (!f)
+            error(2, 0, "worker %u terminated unexpectedly", i);
+        }
+      while (opt_unique && !seen.insert(f).second);
+      output_formula_checked(f, nullptr, nullptr, count);
+    }
+
+  for (auto& w: workers)
+    {
+      kill(w->pid, SIGKILL);
+      close(w->fd);
+      while (waitpid(w->pid, nullptr, 0) < 0 && errno == EINTR)
+        continue;
+    }
+}
+
 int
 main(int argc, char** argv)
 {
@@ -258,24 +473,10 @@ main(int argc, char** argv)
         error(2, 0, "No atomic proposition supplied?  "
               "Run '%s --help' for usage.", program_name);
 
-      spot::srand(opt_seed);
-
-      spot::randltlgenerator rg
-        (opt->aprops,
-         [&] (){
-          spot::option_map opts;
-          opts.set("output", output);
-          opts.set("tree_size_min", opt_tree_size.min);
-          opts.set("tree_size_max", opt_tree_size.max);
-          opts.set("wf", opt_wf);
-          opts.set("seed", opt_seed);
-          opts.set("simplification_level", simplification_level);
-          opts.set("unique", opt_unique);
-          return opts;
-        }(), opt_pL, opt_pS, opt_pB);
-
       if (opt_dump_priorities)
         {
+          spot::randltlgenerator rg(opt->aprops, generator_options(opt_seed),
+                                    opt_pL, opt_pS, opt_pB);
           switch (output)
             {
             case spot::randltlgenerator::LTL:
@@ -307,20 +508,23 @@ main(int argc, char** argv)
           exit(0);
         }
 
-      while (opt_formulas < 0 || opt_formulas--)
+      if (opt_jobs > 1)
         {
-          static int count = 0;
-          spot::formula f = rg.next();
-          if (!f)
-            {
-              error(2, 0, "failed to generate a new unique formula after %d " \
-                    "trials", spot::randltlgenerator::MAX_TRIALS);
-            }
-          else
-            {
-              output_formula_checked(f, nullptr, nullptr, ++count);
-            }
-        };
+          if (opt_workers > 1)
+            error(2, 0, "options --jobs and --worker are incompatible");
+          generate_in_parallel();
+        }
+      else
+        {
+          if (opt_formulas > 0)
+            opt_formulas = ((unsigned) opt_formulas > opt_worker)
+              ? (opt_formulas - opt_worker + opt_workers - 1) / opt_workers
+              : 0;
+          generate(opt_formulas, [](spot::formula f, int count)
+                   {
+                     output_formula_checked(f, nullptr, nullptr, count);
+                   });
+        }
       flush_cout();
       return 0;
     });
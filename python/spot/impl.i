@@ -50,6 +50,7 @@
 %shared_ptr(spot::twa_graph)
 %shared_ptr(spot::twa_product)
 %shared_ptr(spot::twa_product_init)
+%shared_ptr(spot::twa_product_explicit)
 %shared_ptr(spot::taa_tgba)
 %shared_ptr(spot::taa_tgba_string)
 %shared_ptr(spot::taa_tgba_formula)
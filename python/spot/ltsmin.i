@@ -28,6 +28,7 @@
 %shared_ptr(spot::twa)
 %shared_ptr(spot::kripke)
 %shared_ptr(spot::fair_kripke)
+%shared_ptr(spot::kripke_graph)
 
 %{
 #include <spot/ltsmin/ltsmin.hh>
@@ -41,6 +42,7 @@ using namespace spot;
 %import(module="spot.impl") <spot/tl/apcollect.hh>
 %import(module="spot.impl") <spot/kripke/fairkripke.hh>
 %import(module="spot.impl") <spot/kripke/kripke.hh>
+%import(module="spot.impl") <spot/kripke/kripkegraph.hh>
 
 %exception {
   try {
@@ -54,6 +56,8 @@ using namespace spot;
 
 %rename(model) spot::ltsmin_model;
 %rename(kripke_raw) spot::ltsmin_model::kripke;
+%rename(kripke_cached_raw) spot::ltsmin_model::kripke_cached;
+%ignore spot::ltsmin_model::handle_kripke;
 %include <spot/ltsmin/ltsmin.hh>
 
 %pythoncode %{
@@ -69,11 +73,18 @@ def load(filename):
 class model:
   def kripke(self, ap_set, dict=spot._bdd_dict,
 	      dead=spot.formula_ap('dead'),
-	      compress=2):
+	      compress=2, por=False):
     s = spot.atomic_prop_set()
     for ap in ap_set:
       s.insert(spot.formula_ap(ap))
-    return self.kripke_raw(s, dict, dead, compress)
+    return self.kripke_raw(s, dict, dead, compress, por)
+
+  def kripke_cached(self, filename, ap_set, dict=spot._bdd_dict,
+                    dead=spot.formula_ap('dead')):
+    s = spot.atomic_prop_set()
+    for ap in ap_set:
+      s.insert(spot.formula_ap(ap))
+    return self.kripke_cached_raw(filename, s, dict, dead)
 
   def info(self):
     res = {}
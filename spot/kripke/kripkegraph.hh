@@ -143,6 +143,18 @@ namespace spot
       return const_cast<kripke_graph_state*>
         (&g_->state_data(g_->edge_storage(p_).dst));
     }
+
+    virtual unsigned fill(std::vector<twa_succ>& buf) override
+    {
+      unsigned n = 0;
+      for (p_ = t_; p_; p_ = g_->edge_storage(p_).next_succ)
+        {
+          buf.push_back({&g_->state_data(g_->edge_storage(p_).dst),
+                         cond_, {}});
+          ++n;
+        }
+      return n;
+    }
   };
 
 
@@ -19,10 +19,14 @@
 
 #include "config.h"
 #include <ltdl.h>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <fstream>
 #include <vector>
 #include <sstream>
+#include <unordered_map>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -32,11 +36,13 @@
 #endif
 
 #include <spot/ltsmin/ltsmin.hh>
+#include <spot/kripke/kripkegraph.hh>
 #include <spot/misc/hashfunc.hh>
 #include <spot/misc/fixpool.hh>
 #include <spot/misc/mspool.hh>
 #include <spot/misc/intvcomp.hh>
 #include <spot/misc/intvcmp2.hh>
+#include <spot/misc/treedb.hh>
 
 using namespace std::string_literals;
 
@@ -61,6 +67,7 @@ namespace spot
   struct spins_interface
   {
     lt_dlhandle handle;        // handle to the dynamic library
+    std::string filename;      // the compiled model that was loaded
     void (*get_initial_state)(void *to);
     int (*have_property)();
     int (*get_successors)(void* m, int *in, TransitionCB, void *arg);
@@ -71,6 +78,12 @@ namespace spot
     const char* (*get_type_name)(int type);
     int (*get_type_value_count)(int type);
     const char* (*get_type_value_name)(int type, int value);
+    // The following functions are optional.  They are needed for
+    // partial-order reduction.
+    int (*get_transition_count)();
+    const int* (*get_transition_read_dependencies)(int t);
+    const int* (*get_transition_write_dependencies)(int t);
+    int (*get_successor)(void* m, int t, int *in, TransitionCB, void *arg);
 
     ~spins_interface()
     {
@@ -222,6 +235,7 @@ namespace spot
       void* pool;
       int* compressed;
       void (*compress)(const int*, size_t, int*, size_t&);
+      int_vector_tree_db* tree;
 
       ~callback_context()
       {
@@ -260,6 +274,19 @@ namespace spot
       ctx->transitions.emplace_back(out);
     }
 
+    // With tree compression, a state is represented by a spins_state
+    // of size 1, holding the number of its vector in the tree database.
+    void transition_callback_tree(void* arg, transition_info_t*, int *dst)
+    {
+      callback_context* ctx = static_cast<callback_context*>(arg);
+      fixed_size_pool* p = static_cast<fixed_size_pool*>(ctx->pool);
+      spins_state* out = new(p->allocate()) spins_state(1, p);
+      SPOT_ASSUME(out != nullptr);
+      out->vars[0] = ctx->tree->insert(dst);
+      out->compute_hash();
+      ctx->transitions.emplace_back(out);
+    }
+
     ////////////////////////////////////////////////////////////////////////
     // SUCC_ITERATOR
 
@@ -307,6 +334,14 @@ namespace spot
         return (*it_)->clone();
       }
 
+      virtual unsigned fill(std::vector<twa_succ>& buf) override
+      {
+        for (auto t: cc_->transitions)
+          buf.push_back({t->clone(), cond_, {}});
+        it_ = cc_->transitions.end();
+        return cc_->transitions.size();
+      }
+
     private:
       const callback_context* cc_;
       callback_context::transitions_t::const_iterator it_;
@@ -335,10 +370,13 @@ namespace spot
     };
 
 
+    // Register the propositions of APS in DICT for OWNER, and record
+    // how to evaluate them on the states of D in OUT.
     void
     convert_aps(const atomic_prop_set* aps,
                 spins_interface_ptr d,
                 bdd_dict_ptr dict,
+                const void* owner,
                 formula dead,
                 prop_set& out)
     {
@@ -465,7 +503,7 @@ namespace spot
                 }
 
               // Record that X.Y must be equal to Z.
-              int v = dict->register_proposition(*ap, d.get());
+              int v = dict->register_proposition(*ap, owner);
               one_prop p = { ni->second.num, OP_EQ, ei->second, v };
               out.emplace_back(p);
               free(name);
@@ -476,7 +514,7 @@ namespace spot
 
           if (!*s)                // No operator?  Assume "!= 0".
             {
-              int v = dict->register_proposition(*ap, d);
+              int v = dict->register_proposition(*ap, owner);
               one_prop p = { var_num, OP_NE, 0, v };
               out.emplace_back(p);
               free(name);
@@ -594,7 +632,7 @@ namespace spot
             }
 
 
-          int v = dict->register_proposition(*ap, d);
+          int v = dict->register_proposition(*ap, owner);
           one_prop p = { var_num, op, val, v };
           out.emplace_back(p);
         }
@@ -603,6 +641,317 @@ namespace spot
         throw std::runtime_error(err.str());
     }
 
+    // The conjunction of the propositions of PS, evaluated on VARS.
+    bdd
+    eval_prop_set(const prop_set& ps, const int* vars)
+    {
+      bdd res = bddtrue;
+      for (auto& i: ps)
+        {
+          int l = vars[i.var_num];
+          int r = i.val;
+
+          bool cond = false;
+          switch (i.op)
+            {
+            case OP_EQ:
+              cond = (l == r);
+              break;
+            case OP_NE:
+              cond = (l != r);
+              break;
+            case OP_LT:
+              cond = (l < r);
+              break;
+            case OP_GT:
+              cond = (l > r);
+              break;
+            case OP_LE:
+              cond = (l <= r);
+              break;
+            case OP_GE:
+              cond = (l >= r);
+              break;
+            }
+
+          if (cond)
+            res &= bdd_ithvar(i.bddvar);
+          else
+            res &= bdd_nithvar(i.bddvar);
+        }
+      return res;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // PARTIAL-ORDER REDUCTION
+
+    // Select, in each state, a stubborn set of transition groups
+    // using the read and write dependency matrices of the model.
+    //
+    // Two groups are dependent if one of them writes a variable that
+    // the other one reads or writes.  The stubborn set T built from
+    // an enabled seed group is closed under the following rules:
+    //  - if t in T is enabled, all the groups dependent on t are in T;
+    //  - if t in T is disabled, all the groups that write a variable
+    //    read by t (a necessary enabling set for t) are in T.
+    // Additionally, T may not contain any enabled visible group, i.e.,
+    // a group that writes a variable read by some observed atomic
+    // proposition, unless the state is fully expanded.  Only the
+    // successors by the enabled groups of T are kept, and we try all
+    // seeds to keep the smallest set.
+    //
+    // The cycle proviso is ensured by numbering the states in the
+    // order in which they are discovered: a state is fully expanded
+    // whenever one of its reduced successors has a number smaller
+    // than or equal to its own.  Every cycle of the reduced state
+    // space therefore contains a fully expanded state, whatever the
+    // order in which the emptiness check explores the product.
+    // Because a state can be expanded multiple times (e.g., once for
+    // each state of the property automaton it is paired with), that
+    // decision is remembered.
+    //
+    // Together, these conditions ensure that the reduced Kripke
+    // structure satisfies the same stutter-invariant properties as
+    // the full one.
+    class spins_por final
+    {
+    public:
+      spins_por(const spins_interface* d, const prop_set* ps)
+        : ngroups_(d->get_transition_count()),
+          count_(ngroups_), mark_(ngroups_, 0), chosen_(ngroups_, 0),
+          dep_(ngroups_), nes_(ngroups_), visible_(ngroups_, false)
+      {
+        unsigned nvars = d->get_state_size();
+        unsigned nwords = (nvars + 63) / 64;
+        typedef std::vector<uint64_t> varset;
+        auto read_matrix = [&](const int* row)
+          {
+            varset res(nwords, 0);
+            for (unsigned v = 0; v < nvars; ++v)
+              if (row[v])
+                res[v / 64] |= uint64_t(1) << (v % 64);
+            return res;
+          };
+        auto intersects = [nwords](const varset& a, const varset& b)
+          {
+            for (unsigned w = 0; w < nwords; ++w)
+              if (a[w] & b[w])
+                return true;
+            return false;
+          };
+        std::vector<varset> reads;
+        std::vector<varset> writes;
+        reads.reserve(ngroups_);
+        writes.reserve(ngroups_);
+        for (unsigned t = 0; t < ngroups_; ++t)
+          {
+            reads.emplace_back(read_matrix
+                               (d->get_transition_read_dependencies(t)));
+            writes.emplace_back(read_matrix
+                                (d->get_transition_write_dependencies(t)));
+          }
+        varset observed(nwords, 0);
+        for (auto& p: *ps)
+          observed[p.var_num / 64] |= uint64_t(1) << (p.var_num % 64);
+
+        for (unsigned t = 0; t < ngroups_; ++t)
+          {
+            if (intersects(writes[t], observed))
+              visible_[t] = true;
+            for (unsigned u = 0; u < ngroups_; ++u)
+              {
+                if (u == t)
+                  continue;
+                bool u_enables_t = intersects(writes[u], reads[t]);
+                if (u_enables_t)
+                  nes_[t].push_back(u);
+                if (u_enables_t
+                    || intersects(writes[t], reads[u])
+                    || intersects(writes[t], writes[u]))
+                  dep_[t].push_back(u);
+              }
+          }
+      }
+
+      ~spins_por()
+      {
+        for (auto& p: info_)
+          p.first->destroy();
+      }
+
+      unsigned group_count() const
+      {
+        return ngroups_;
+      }
+
+      // The number of successors of each group in the current state.
+      // This should be filled before calling reduce().
+      std::vector<int>& counts()
+      {
+        return count_;
+      }
+
+      // Remove from succs (the successors of st, ordered by group)
+      // those that are not needed.
+      void reduce(const state* st, callback_context::transitions_t& succs)
+      {
+        enabled_.clear();
+        for (unsigned g = 0; g < ngroups_; ++g)
+          if (count_[g])
+            enabled_.push_back(g);
+        unsigned nenabled = enabled_.size();
+        if (nenabled <= 1)
+          return;
+
+        auto it = info_.find(st);
+        if (it == info_.end())
+          it = info_.emplace(st->clone(), state_info{next_num_++}).first;
+        // This reference stays valid when info_ is rehashed.
+        state_info& si = it->second;
+        if (si.decided && si.full)
+          return;
+
+        // Find the smallest stubborn set.
+        best_.clear();
+        unsigned best_size = nenabled;
+        for (int seed: enabled_)
+          {
+            unsigned sz = closure(seed, best_size);
+            if (sz < best_size)
+              {
+                best_size = sz;
+                best_.swap(cur_);
+                if (sz == 1)
+                  break;
+              }
+          }
+        if (best_size == nenabled)
+          {
+            si.decided = si.full = true;
+            return;
+          }
+        for (int g: best_)
+          chosen_[g] = 1;
+
+        // Cycle proviso, only checked the first time st is expanded.
+        if (!si.decided)
+          {
+            si.decided = true;
+            unsigned num = si.num;
+            auto sit = succs.begin();
+            for (unsigned g = 0; g < ngroups_ && !si.full; ++g)
+              for (int n = count_[g]; n > 0; --n, ++sit)
+                if (chosen_[g])
+                  {
+                    auto i = info_.find(*sit);
+                    if (i != info_.end() && i->second.num <= num)
+                      {
+                        si.full = true;
+                        break;
+                      }
+                  }
+            if (!si.full)
+              {
+                sit = succs.begin();
+                for (unsigned g = 0; g < ngroups_; ++g)
+                  for (int n = count_[g]; n > 0; --n, ++sit)
+                    if (chosen_[g] && info_.find(*sit) == info_.end())
+                      info_.emplace((*sit)->clone(),
+                                    state_info{next_num_++});
+              }
+          }
+
+        if (!si.full)
+          {
+            auto sit = succs.begin();
+            for (unsigned g = 0; g < ngroups_; ++g)
+              for (int n = count_[g]; n > 0; --n)
+                if (chosen_[g])
+                  {
+                    ++sit;
+                  }
+                else
+                  {
+                    (*sit)->destroy();
+                    sit = succs.erase(sit);
+                  }
+          }
+        for (int g: best_)
+          chosen_[g] = 0;
+      }
+
+    private:
+      // Compute in cur_ the enabled groups of the stubborn set built
+      // from seed.  Give up (returning bound) as soon as bound enabled
+      // groups are found, or if an enabled group is visible.
+      unsigned closure(int seed, unsigned bound)
+      {
+        if (SPOT_UNLIKELY(++stamp_ == 0))
+          {
+            std::fill(mark_.begin(), mark_.end(), 0);
+            stamp_ = 1;
+          }
+        cur_.clear();
+        work_.clear();
+        auto add = [this](int g)
+          {
+            if (mark_[g] != stamp_)
+              {
+                mark_[g] = stamp_;
+                work_.push_back(g);
+              }
+          };
+        add(seed);
+        while (!work_.empty())
+          {
+            int g = work_.back();
+            work_.pop_back();
+            if (count_[g])
+              {
+                cur_.push_back(g);
+                if (visible_[g] || cur_.size() >= bound)
+                  return bound;
+                for (int u: dep_[g])
+                  add(u);
+              }
+            else
+              {
+                for (int u: nes_[g])
+                  add(u);
+              }
+          }
+        return cur_.size();
+      }
+
+      struct state_info
+      {
+        unsigned num;           // discovery number
+        bool decided;           // whether st has already been expanded
+        bool full;              // whether st is fully expanded
+
+        state_info(unsigned num)
+          : num(num), decided(false), full(false)
+        {
+        }
+      };
+
+      unsigned ngroups_;
+      std::vector<int> count_;
+      std::vector<unsigned> mark_;
+      unsigned stamp_ = 0;
+      std::vector<char> chosen_;
+      std::vector<std::vector<int>> dep_;
+      std::vector<std::vector<int>> nes_;
+      std::vector<bool> visible_;
+      std::vector<int> enabled_;
+      std::vector<int> cur_;
+      std::vector<int> best_;
+      std::vector<int> work_;
+      std::unordered_map<const state*, state_info,
+                         state_ptr_hash, state_ptr_equal> info_;
+      unsigned next_num_ = 0;
+    };
+
     ////////////////////////////////////////////////////////////////////////
     // KRIPKE
 
@@ -612,24 +961,27 @@ namespace spot
 
       spins_kripke(spins_interface_ptr d, const bdd_dict_ptr& dict,
                    const spot::prop_set* ps, formula dead,
-                   int compress)
+                   int compress, bool por)
         : kripke(dict),
           d_(d),
           state_size_(d_->get_state_size()),
           ps_(ps),
-          compress_(compress == 0 ? nullptr
-                    : compress == 1 ? int_array_array_compress
-                    : int_array_array_compress2),
-          decompress_(compress == 0 ? nullptr
-                      : compress == 1 ? int_array_array_decompress
-                      : int_array_array_decompress2),
+          compress_(compress == 1 ? int_array_array_compress
+                    : compress == 2 ? int_array_array_compress2
+                    : nullptr),
+          decompress_(compress == 1 ? int_array_array_decompress
+                      : compress == 2 ? int_array_array_decompress2
+                      : nullptr),
+          tree_(compress == 3 ? new int_vector_tree_db(state_size_)
+                : nullptr),
           uncompressed_(compress ? new int[state_size_ + 30] : nullptr),
-          compressed_(compress ? new int[state_size_ * 2] : nullptr),
-          statepool_(compress ?
+          compressed_(compress_ ? new int[state_size_ * 2] : nullptr),
+          statepool_(compress_ ?
                      (sizeof(spins_compressed_state)
                       - sizeof(spins_compressed_state::vars)) :
                      (sizeof(spins_state) - sizeof(spins_state::vars)
-                      + (state_size_ * sizeof(int)))),
+                      + ((tree_ ? 1 : state_size_) * sizeof(int)))),
+          por_(por ? new spins_por(d_.get(), ps) : nullptr),
           state_condition_last_state_(nullptr),
           state_condition_last_cc_(nullptr)
       {
@@ -686,11 +1038,9 @@ namespace spot
           }
         delete[] format_filter_;
         delete[] vname_;
-        if (compress_)
-          {
-            delete[] uncompressed_;
-            delete[] compressed_;
-          }
+        delete[] uncompressed_;
+        delete[] compressed_;
+        delete tree_;
         dict_->unregister_all_my_variables(d_.get());
 
         delete ps_;
@@ -698,6 +1048,7 @@ namespace spot
         if (state_condition_last_state_)
           state_condition_last_state_->destroy();
         delete state_condition_last_cc_; // Might be 0 already.
+        delete por_;
       }
 
       virtual state* get_init_state() const override
@@ -720,6 +1071,16 @@ namespace spot
             res->compute_hash();
             return res;
           }
+        else if (tree_)
+          {
+            d_->get_initial_state(uncompressed_);
+            fixed_size_pool* p = const_cast<fixed_size_pool*>(&statepool_);
+            spins_state* res = new(p->allocate()) spins_state(1, p);
+            SPOT_ASSUME(res != nullptr);
+            res->vars[0] = tree_->insert(uncompressed_);
+            res->compute_hash();
+            return res;
+          }
         else
           {
             fixed_size_pool* p = const_cast<fixed_size_pool*>(&statepool_);
@@ -734,44 +1095,11 @@ namespace spot
       bdd
       compute_state_condition_aux(const int* vars) const
       {
-        bdd res = bddtrue;
-        for (auto& i: *ps_)
-          {
-            int l = vars[i.var_num];
-            int r = i.val;
-
-            bool cond = false;
-            switch (i.op)
-              {
-              case OP_EQ:
-                cond = (l == r);
-                break;
-              case OP_NE:
-                cond = (l != r);
-                break;
-              case OP_LT:
-                cond = (l < r);
-                break;
-              case OP_GT:
-                cond = (l > r);
-                break;
-              case OP_LE:
-                cond = (l <= r);
-                break;
-              case OP_GE:
-                cond = (l >= r);
-                break;
-              }
-
-            if (cond)
-              res &= bdd_ithvar(i.bddvar);
-            else
-              res &= bdd_nithvar(i.bddvar);
-          }
-        return res;
+        return eval_prop_set(*ps_, vars);
       }
 
-      callback_context* build_cc(const int* vars, int& t) const
+      callback_context* build_cc(const state* st, const int* vars,
+                                 int& t) const
       {
         callback_context* cc = new callback_context;
         cc->state_size = state_size_;
@@ -781,12 +1109,32 @@ namespace spot
                             : static_cast<const void*>(&statepool_));
         cc->compress = compress_;
         cc->compressed = compressed_;
-        t = d_->get_successors(nullptr, const_cast<int*>(vars),
-                               compress_
-                               ? transition_callback_compress
-                               : transition_callback,
-                               cc);
+        cc->tree = tree_;
+        TransitionCB callback =
+          compress_ ? transition_callback_compress
+          : tree_ ? transition_callback_tree
+          : transition_callback;
+        if (!por_)
+          {
+            t = d_->get_successors(nullptr, const_cast<int*>(vars),
+                                   callback, cc);
+          }
+        else
+          {
+            // Compute the successors group by group, so that the
+            // partial-order reduction knows which group produced
+            // which successor.  T is the number of successors before
+            // reduction, so that dead states are still recognized.
+            std::vector<int>& count = por_->counts();
+            t = 0;
+            for (unsigned g = 0, n = por_->group_count(); g < n; ++g)
+              t += count[g] = d_->get_successor(nullptr, g,
+                                                const_cast<int*>(vars),
+                                                callback, cc);
+          }
         assert((unsigned)t == cc->transitions.size());
+        if (por_ && t)
+          por_->reduce(st, cc->transitions);
         return cc;
       }
 
@@ -808,7 +1156,7 @@ namespace spot
 
         bdd res = compute_state_condition_aux(vars);
         int t;
-        callback_context* cc = build_cc(vars, t);
+        callback_context* cc = build_cc(st, vars, t);
 
         if (t)
           {
@@ -842,6 +1190,12 @@ namespace spot
             decompress_(s->vars, s->size, uncompressed_, state_size_);
             vars = uncompressed_;
           }
+        else if (tree_)
+          {
+            const spins_state* s = down_cast<const spins_state*>(st);
+            tree_->get(s->vars[0], uncompressed_);
+            vars = uncompressed_;
+          }
         else
           {
             const spins_state* s = down_cast<const spins_state*>(st);
@@ -866,7 +1220,7 @@ namespace spot
         else
           {
             int t;
-            cc = build_cc(get_vars(st), t);
+            cc = build_cc(st, get_vars(st), t);
 
             // Add a self-loop to dead-states if we care about these.
             if (t == 0 && scond != bddfalse)
@@ -929,10 +1283,12 @@ namespace spot
       bdd dead_prop;
       void (*compress_)(const int*, size_t, int*, size_t&);
       void (*decompress_)(const int*, size_t, int*, size_t);
+      int_vector_tree_db* tree_;
       int* uncompressed_;
       int* compressed_;
       fixed_size_pool statepool_;
       multiple_size_pool compstatepool_;
+      spins_por* por_;
 
       // This cache is used to speedup repeated calls to state_condition()
       // and get_succ().
@@ -945,6 +1301,239 @@ namespace spot
     };
 
 
+    ////////////////////////////////////////////////////////////////////////
+    // KRIPKE WITH STATE HANDLES
+
+    // The state vectors are stored back to back in a single array, and
+    // the handle of a state is its position in this array divided by
+    // the size of the vectors.  An open-addressing hash table maps
+    // state vectors to handles.
+    class spins_handles final: public handle_twa
+    {
+    public:
+      spins_handles(spins_interface_ptr d, const bdd_dict_ptr& dict,
+                    const spot::prop_set* ps, formula dead)
+        : handle_twa(dict, acc_cond(0, acc_cond::acc_code::t())),
+          d_(d),
+          state_size_(d_->get_state_size()),
+          ps_(ps),
+          src_(state_size_),
+          dst_(state_size_),
+          table_(1024, 0)
+      {
+        kripke_ = true;
+        // See spins_kripke for the meaning of DEAD.
+        if (dead.is_ff())
+          {
+            alive_prop_ = bddtrue;
+            dead_prop_ = bddfalse;
+          }
+        else if (dead.is_tt())
+          {
+            alive_prop_ = bddtrue;
+            dead_prop_ = bddtrue;
+          }
+        else
+          {
+            int var = dict->register_proposition(dead, ps_);
+            dead_prop_ = bdd_ithvar(var);
+            alive_prop_ = bdd_nithvar(var);
+          }
+      }
+
+      // The propositions are registered for PS_, not for the model
+      // interface that other automata of the same model also use.
+      ~spins_handles()
+      {
+        dict_->unregister_all_my_variables(ps_);
+        delete ps_;
+      }
+
+      state_handle get_init_state() const override
+      {
+        d_->get_initial_state(dst_.data());
+        return intern(dst_.data());
+      }
+
+      unsigned succ(state_handle s,
+                    std::vector<handle_succ>& out) const override
+      {
+        // Interning the successors may reallocate vars_, so work on
+        // a copy of the source vector.
+        const int* vars = vars_.data() + s * state_size_;
+        std::copy(vars, vars + state_size_, src_.begin());
+        bdd cond = eval_prop_set(*ps_, src_.data());
+        succs_.clear();
+        int t = d_->get_successors(nullptr, src_.data(),
+                                   handle_callback,
+                                   const_cast<spins_handles*>(this));
+        if (t)
+          {
+            cond &= alive_prop_;
+          }
+        else
+          {
+            cond &= dead_prop_;
+            // Add a self-loop to dead-states if we care about these.
+            if (cond != bddfalse)
+              succs_.push_back(s);
+          }
+        for (state_handle d: succs_)
+          out.push_back({d, cond, {}});
+        return succs_.size();
+      }
+
+      size_t num_states() const override
+      {
+        return count_;
+      }
+
+      std::string format_state(state_handle s) const override
+      {
+        const int* vars = vars_.data() + s * state_size_;
+        std::ostringstream res;
+        if (state_size_ == 0)
+          return "empty state";
+        const char* sep = "";
+        for (int i = 0; i < state_size_; ++i)
+          {
+            // Skip variables that can take a single value, as
+            // spins_kripke::format_state() does.
+            int type = d_->get_state_variable_type(i);
+            if (d_->get_type_value_count(type) == 1)
+              continue;
+            res << sep << d_->get_state_variable_name(i) << '=' << vars[i];
+            sep = ", ";
+          }
+        return res.str();
+      }
+
+      // The state vector of S.
+      const int* state_vars(state_handle s) const
+      {
+        return vars_.data() + s * state_size_;
+      }
+
+    private:
+      static void handle_callback(void* arg, transition_info_t*, int* dst)
+      {
+        const spins_handles* self = static_cast<const spins_handles*>(arg);
+        self->succs_.push_back(self->intern(dst));
+      }
+
+      size_t hash(const int* vars) const
+      {
+        size_t h = 0;
+        for (int i = 0; i < state_size_; ++i)
+          h = wang32_hash(h ^ vars[i]);
+        return h;
+      }
+
+      // Return the handle of VARS, storing it if needed.
+      state_handle intern(const int* vars) const
+      {
+        size_t mask = table_.size() - 1;
+        size_t pos = hash(vars) & mask;
+        size_t bytes = state_size_ * sizeof(int);
+        // Slots hold handle + 1, and 0 when empty.
+        while (state_handle slot = table_[pos])
+          {
+            if (!memcmp(vars_.data() + (slot - 1) * state_size_,
+                        vars, bytes))
+              return slot - 1;
+            pos = (pos + 1) & mask;
+          }
+        state_handle res = count_++;
+        vars_.insert(vars_.end(), vars, vars + state_size_);
+        table_[pos] = res + 1;
+        if (2 * count_ > table_.size())
+          grow();
+        return res;
+      }
+
+      void grow() const
+      {
+        std::vector<state_handle> table(table_.size() * 2, 0);
+        size_t mask = table.size() - 1;
+        for (state_handle h = 0; h < count_; ++h)
+          {
+            size_t pos = hash(vars_.data() + h * state_size_) & mask;
+            while (table[pos])
+              pos = (pos + 1) & mask;
+            table[pos] = h + 1;
+          }
+        std::swap(table, table_);
+      }
+
+      spins_interface_ptr d_;
+      int state_size_;
+      const spot::prop_set* ps_;
+      bdd alive_prop_;
+      bdd dead_prop_;
+      mutable std::vector<int> src_;
+      mutable std::vector<int> dst_;
+      mutable std::vector<int> vars_;
+      mutable std::vector<state_handle> table_;
+      mutable state_handle count_ = 0;
+      mutable std::vector<state_handle> succs_;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // STATE-SPACE CACHE
+
+    // A cache file starts with the following header, which identifies
+    // the model: the size and modification time of the compiled model,
+    // its variables, and its initial state.  It is followed by the
+    // number of states, the state vectors, and for each state its
+    // number of successors followed by their numbers.  Numbers are
+    // stored as 32-bit integers in the byte order of the machine.
+    std::string
+    cache_header(const spins_interface_ptr& d)
+    {
+      struct stat st;
+      if (stat(d->filename.c_str(), &st) != 0)
+        throw std::runtime_error("Cannot stat `" + d->filename + "'.");
+      std::ostringstream os;
+      int state_size = d->get_state_size();
+      os << "SPOT-LTSMIN-CACHE 2\n"
+         << st.st_size << ' ' << st.st_mtime << '\n'
+         << state_size << '\n';
+      for (int i = 0; i < state_size; ++i)
+        os << d->get_state_variable_name(i) << '\n';
+      std::vector<int> init(state_size);
+      d->get_initial_state(init.data());
+      for (int v: init)
+        os << v << ' ';
+      os << '\n';
+      return os.str();
+    }
+
+    bool
+    read_cache_header(std::istream& in, const std::string& header)
+    {
+      std::string buf(header.size(), '\0');
+      return (in.read(&buf[0], buf.size()) && buf == header);
+    }
+
+    template<typename T>
+    void
+    write_ints(std::ostream& out, const T* data, size_t n)
+    {
+      static_assert(sizeof(T) == 4, "cache files store 32-bit integers");
+      out.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+    }
+
+    template<typename T>
+    void
+    read_ints(std::istream& in, T* data, size_t n,
+              const std::string& filename)
+    {
+      static_assert(sizeof(T) == 4, "cache files store 32-bit integers");
+      if (!in.read(reinterpret_cast<char*>(data), n * sizeof(T)))
+        throw std::runtime_error("Cache file `" + filename
+                                 + "' is truncated.");
+    }
+
     //////////////////////////////////////////////////////////////////////////
     // LOADER
 
@@ -1039,6 +1628,7 @@ namespace spot
     assert(d); // Superfluous, but Debian's GCC 7 snapshot 20161207-1 warns
                // about potential null pointer dereference on the next line.
     d->handle = h;
+    d->filename = file;
 
 
     auto sym = [&](auto* dst, const char* name)
@@ -1086,6 +1676,21 @@ namespace spot
       throw std::runtime_error("Models with embedded properties "
                                "are not supported.");
 
+    // Optional symbols, used for partial-order reduction.
+    auto try_sym = [&](auto* dst, const char* name)
+      {
+        *reinterpret_cast<void**>(dst) = lt_dlsym(h, name);
+      };
+    const char* prefix = ext == ".spins" ? "spins_" : "";
+    try_sym(&d->get_transition_count,
+            ext == ".spins" ? "spins_get_transition_groups"
+            : "get_transition_count");
+    try_sym(&d->get_transition_read_dependencies,
+            (prefix + "get_transition_read_dependencies"s).c_str());
+    try_sym(&d->get_transition_write_dependencies,
+            (prefix + "get_transition_write_dependencies"s).c_str());
+    try_sym(&d->get_successor, (prefix + "get_successor"s).c_str());
+
     return { d };
   }
 
@@ -1093,12 +1698,22 @@ namespace spot
   kripke_ptr
   ltsmin_model::kripke(const atomic_prop_set* to_observe,
                        bdd_dict_ptr dict,
-                       const formula dead, int compress) const
+                       const formula dead, int compress, bool por) const
   {
+    if (compress < 0 || compress > 3)
+      throw std::runtime_error("Unknown compression level "
+                               + std::to_string(compress) + '.');
+    if (por && !(iface->get_transition_count
+                 && iface->get_transition_read_dependencies
+                 && iface->get_transition_write_dependencies
+                 && iface->get_successor))
+      throw std::runtime_error("Partial-order reduction requires a model "
+                               "that exports its transition groups and "
+                               "their dependency matrices.");
     spot::prop_set* ps = new spot::prop_set;
     try
       {
-        convert_aps(to_observe, iface, dict, dead, *ps);
+        convert_aps(to_observe, iface, dict, iface.get(), dead, *ps);
       }
     catch (const std::runtime_error&)
       {
@@ -1107,7 +1722,8 @@ namespace spot
         throw;
       }
     auto res = SPOT_make_shared_enabled__(spins_kripke,
-                                          iface, dict, ps, dead, compress);
+                                          iface, dict, ps, dead, compress,
+                                          por);
     // All atomic propositions have been registered to the bdd_dict
     // for iface, but we also need to add them to the automaton so
     // twa::ap() works.
@@ -1118,6 +1734,164 @@ namespace spot
     return res;
   }
 
+  handle_twa_ptr
+  ltsmin_model::handle_kripke(const atomic_prop_set* to_observe,
+                              bdd_dict_ptr dict, const formula dead) const
+  {
+    spot::prop_set* ps = new spot::prop_set;
+    try
+      {
+        convert_aps(to_observe, iface, dict, ps, dead, *ps);
+      }
+    catch (const std::runtime_error&)
+      {
+        dict->unregister_all_my_variables(ps);
+        delete ps;
+        throw;
+      }
+    return std::make_shared<spins_handles>(iface, dict, ps, dead);
+  }
+
+  void
+  ltsmin_model::save_state_space(const std::string& filename) const
+  {
+    // Explore the state space without observing any proposition, and
+    // without self-loops on dead states: those are added when the
+    // cache is loaded.
+    spins_handles h(iface, make_bdd_dict(), new spot::prop_set,
+                    formula::ff());
+    std::vector<handle_succ> succs;
+    std::vector<uint32_t> edges;
+    for (state_handle s = h.get_init_state(); s < h.num_states(); ++s)
+      {
+        succs.clear();
+        edges.push_back(h.succ(s, succs));
+        for (auto& e: succs)
+          edges.push_back(e.dst);
+      }
+    if (h.num_states() > UINT32_MAX)
+      throw std::runtime_error("The state space is too large to be cached.");
+    uint32_t n = h.num_states();
+
+    // Write to a temporary file that is renamed at the end, so that
+    // concurrent readers never see a partial cache.
+    std::string tmp = filename + ".tmp" + std::to_string(getpid());
+    {
+      std::ofstream out(tmp, std::ios::binary);
+      if (!out)
+        throw std::runtime_error("Cannot open `" + tmp + "' for writing.");
+      out << cache_header(iface);
+      write_ints(out, &n, 1);
+      for (uint32_t s = 0; s < n; ++s)
+        write_ints(out, h.state_vars(s), iface->get_state_size());
+      write_ints(out, edges.data(), edges.size());
+      if (!out.flush())
+        {
+          std::remove(tmp.c_str());
+          throw std::runtime_error("Error while writing `" + tmp + "'.");
+        }
+    }
+    if (std::rename(tmp.c_str(), filename.c_str()))
+      {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Cannot rename `" + tmp + "' as `"
+                                 + filename + "'.");
+      }
+  }
+
+  kripke_graph_ptr
+  ltsmin_model::kripke_cached(const std::string& filename,
+                              const atomic_prop_set* to_observe,
+                              bdd_dict_ptr dict, formula dead) const
+  {
+    std::string header = cache_header(iface);
+    std::ifstream in(filename, std::ios::binary);
+    if (!in || !read_cache_header(in, header))
+      {
+        in.close();
+        save_state_space(filename);
+        in.open(filename, std::ios::binary);
+        if (!in || !read_cache_header(in, header))
+          throw std::runtime_error("Cannot read cache file `"
+                                   + filename + "'.");
+      }
+    uint32_t n;
+    read_ints(in, &n, 1, filename);
+    if (n == 0)
+      throw std::runtime_error("Cache file `" + filename
+                               + "' has no state.");
+    int state_size = iface->get_state_size();
+    std::vector<int> vars(static_cast<size_t>(n) * state_size);
+    read_ints(in, vars.data(), vars.size(), filename);
+
+    // The propositions are registered for PS until they are
+    // registered for the resulting automaton, so that we do not
+    // touch those registered for other automata built from this
+    // model.
+    spot::prop_set ps;
+    try
+      {
+        convert_aps(to_observe, iface, dict, &ps, dead, ps);
+      }
+    catch (const std::runtime_error&)
+      {
+        dict->unregister_all_my_variables(&ps);
+        throw;
+      }
+
+    auto res = make_kripke_graph(dict);
+    for (auto ap: *to_observe)
+      res->register_ap(ap);
+    // See spins_kripke for the meaning of DEAD.
+    bdd alive_prop = bddtrue;
+    bdd dead_prop = bddtrue;
+    if (dead.is_ff())
+      {
+        dead_prop = bddfalse;
+      }
+    else if (!dead.is_tt())
+      {
+        int var = res->register_ap(dead);
+        dead_prop = bdd_ithvar(var);
+        alive_prop = bdd_nithvar(var);
+      }
+    // The propositions are now registered for RES.
+    dict->unregister_all_my_variables(&ps);
+
+    res->new_states(n, bddfalse);
+    std::vector<uint32_t> dsts;
+    for (uint32_t s = 0; s < n; ++s)
+      {
+        uint32_t count;
+        read_ints(in, &count, 1, filename);
+        bdd cond = eval_prop_set(ps, vars.data()
+                                 + static_cast<size_t>(s) * state_size);
+        if (count)
+          {
+            cond &= alive_prop;
+            dsts.resize(count);
+            read_ints(in, dsts.data(), count, filename);
+            for (uint32_t d: dsts)
+              {
+                if (d >= n)
+                  throw std::runtime_error("Cache file `" + filename
+                                           + "' is corrupted.");
+                res->new_edge(s, d);
+              }
+          }
+        else
+          {
+            cond &= dead_prop;
+            // Add a self-loop to dead-states if we care about these.
+            if (cond != bddfalse)
+              res->new_edge(s, s);
+          }
+        res->state_from_number(s)->cond(cond);
+      }
+    res->set_init_state(0);
+    return res;
+  }
+
   ltsmin_model::~ltsmin_model()
   {
   }
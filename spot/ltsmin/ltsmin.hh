@@ -19,8 +19,9 @@
 
 #pragma once
 
-#include <spot/kripke/kripke.hh>
+#include <spot/kripke/kripkegraph.hh>
 #include <spot/tl/apcollect.hh>
+#include <spot/twa/twahandle.hh>
 
 namespace spot
 {
@@ -65,11 +66,58 @@ namespace spot
     //         dead states
     // \a compress whether to compress the states.  Use 0 to disable, 1
     // to enable compression, 2 to enable a faster compression that only
-    // work if all variables are smaller than 2^28.
+    // work if all variables are smaller than 2^28, 3 to store the states
+    // in a tree database (see int_vector_tree_db), which is best when
+    // states are long vectors that differ by few variables.
+    // \a por whether to use partial-order reduction.  The successors
+    //         of each state are then restricted to a stubborn set of
+    //         transition groups, computed from the dependency matrices
+    //         of the model and from the variables read by the atomic
+    //         propositions of \a to_observe.  The reduced Kripke
+    //         structure only preserves stutter-invariant properties
+    //         (see check_stutter_invariance()).  This throws an
+    //         std::runtime_error if the model does not export its
+    //         transition groups and dependency matrices.
     kripke_ptr kripke(const atomic_prop_set* to_observe,
                       bdd_dict_ptr dict,
                       formula dead = formula::tt(),
-                      int compress = 0) const;
+                      int compress = 0, bool por = false) const;
+
+    // \brief Generate the state space of the model as a handle_twa.
+    //
+    // The arguments have the same meaning as in kripke().  The
+    // states are stored uncompressed in a single array, and the
+    // algorithms working on the returned automaton never have to
+    // allocate or free state objects.  No partial-order reduction is
+    // supported.
+    handle_twa_ptr handle_kripke(const atomic_prop_set* to_observe,
+                                 bdd_dict_ptr dict,
+                                 formula dead = formula::tt()) const;
+
+    // \brief Explore the whole state space of the model, and save it
+    // to \a filename.
+    //
+    // The file stores the state vectors and the transitions of the
+    // model, but no atomic proposition, so that kripke_cached() can
+    // load it to check any property without calling the model again.
+    // Throw an std::runtime_error if the file cannot be written.
+    void save_state_space(const std::string& filename) const;
+
+    // \brief Load a state space saved by save_state_space().
+    //
+    // If \a filename does not exist, or was saved for another model,
+    // save_state_space() is called first.  A model is identified by
+    // the size and modification time of its compiled file (the
+    // .spins, .dve2C, or .gal2C file), its variables, and its initial
+    // state, so recompiling the model invalidates the cache.  The
+    // arguments \a to_observe, \a dict, and \a dead have the same
+    // meaning as in kripke().  States of the returned kripke_graph are
+    // numbered in the order of the file, and the initial state is 0.
+    // Throw an std::runtime_error if the file is truncated.
+    kripke_graph_ptr kripke_cached(const std::string& filename,
+                                   const atomic_prop_set* to_observe,
+                                   bdd_dict_ptr dict,
+                                   formula dead = formula::tt()) const;
 
     /// Number of variables in a state
     int state_size() const;
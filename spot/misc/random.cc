@@ -22,6 +22,7 @@
 
 #include "config.h"
 #include <spot/misc/random.hh>
+#include <cstdint>
 #include <random>
 
 namespace spot
@@ -34,6 +35,17 @@ namespace spot
     gen.seed(seed);
   }
 
+  unsigned int
+  derive_seed(unsigned int seed, unsigned int stream)
+  {
+    // SplitMix64 finalizer applied to the (seed, stream) pair.
+    uint64_t z = (uint64_t(seed) << 32 | stream) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<unsigned int>(z ^ (z >> 32));
+  }
+
   double
   drand()
   {
@@ -40,6 +40,17 @@ namespace spot
   /// \see drand, mrand, rrand
   SPOT_API void srand(unsigned int seed);
 
+  /// \brief Derive the seed of an independent random stream.
+  ///
+  /// Return a seed for the stream number \a stream, obtained by
+  /// hashing it with \a seed.  This allows several generators (e.g.,
+  /// one per process) to be seeded reproducibly from a single
+  /// user-supplied seed, without their sequences being as correlated
+  /// as they could be with consecutive seeds.
+  ///
+  /// \see srand
+  SPOT_API unsigned int derive_seed(unsigned int seed, unsigned int stream);
+
   /// \brief Compute a pseudo-random integer value between \a min and
   /// \a max included.
   ///
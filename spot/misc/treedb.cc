@@ -0,0 +1,152 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/misc/treedb.hh>
+#include <spot/misc/hashfunc.hh>
+#include <limits>
+#include <stdexcept>
+
+namespace spot
+{
+  namespace
+  {
+    static unsigned
+    pair_hash(uint64_t pair)
+    {
+      return wang32_hash(static_cast<uint32_t>(pair)
+                         ^ wang32_hash(static_cast<uint32_t>(pair >> 32)));
+    }
+
+    static uint64_t
+    pack_pair(unsigned left, unsigned right)
+    {
+      return (static_cast<uint64_t>(left) << 32) | right;
+    }
+  }
+
+  void
+  int_vector_tree_db::pair_table::grow()
+  {
+    unsigned nb = buckets_.empty() ? 16 : 2 * buckets_.size();
+    buckets_.assign(nb, 0);
+    unsigned mask = nb - 1;
+    for (unsigned i = 0, n = pairs_.size(); i < n; ++i)
+      {
+        unsigned b = pair_hash(pairs_[i]) & mask;
+        while (buckets_[b])
+          b = (b + 1) & mask;
+        buckets_[b] = i + 1;
+      }
+  }
+
+  unsigned
+  int_vector_tree_db::pair_table::find_or_insert(uint64_t pair)
+  {
+    // Keep the load factor below 1/2.
+    if (2 * (pairs_.size() + 1) > buckets_.size())
+      {
+        if (SPOT_UNLIKELY(pairs_.size()
+                          >= std::numeric_limits<unsigned>::max() / 2))
+          throw std::runtime_error("int_vector_tree_db: too many vectors");
+        grow();
+      }
+    unsigned mask = buckets_.size() - 1;
+    unsigned b = pair_hash(pair) & mask;
+    while (unsigned i = buckets_[b])
+      {
+        if (pairs_[i - 1] == pair)
+          return i - 1;
+        b = (b + 1) & mask;
+      }
+    unsigned res = pairs_.size();
+    pairs_.push_back(pair);
+    buckets_[b] = res + 1;
+    return res;
+  }
+
+  int_vector_tree_db::int_vector_tree_db(unsigned vector_size)
+    : size_(vector_size)
+  {
+    // A tree with n >= 2 leaves has n-1 internal nodes, but the heap
+    // numbering leaves holes when n is not a power of 2.
+    unsigned n = 1;
+    while (n < size_)
+      n *= 2;
+    tables_.resize(2 * n);
+  }
+
+  unsigned
+  int_vector_tree_db::insert_rec(unsigned node, unsigned lo, unsigned hi,
+                                 const int* vec)
+  {
+    if (hi - lo == 1)
+      return vec[lo];
+    unsigned mid = lo + (hi - lo) / 2;
+    unsigned left = insert_rec(2 * node, lo, mid, vec);
+    unsigned right = insert_rec(2 * node + 1, mid, hi, vec);
+    return tables_[node].find_or_insert(pack_pair(left, right));
+  }
+
+  unsigned
+  int_vector_tree_db::insert(const int* vec)
+  {
+    // Vectors of size 0 and 1 still get a root pair, so that they are
+    // numbered like the others.
+    if (size_ <= 1)
+      return tables_[1].find_or_insert(size_ ? pack_pair(vec[0], 0) : 0);
+    return insert_rec(1, 0, size_, vec);
+  }
+
+  void
+  int_vector_tree_db::get_rec(unsigned node, unsigned lo, unsigned hi,
+                              unsigned index, int* vec) const
+  {
+    if (hi - lo == 1)
+      {
+        vec[lo] = index;
+        return;
+      }
+    uint64_t pair = tables_[node][index];
+    unsigned mid = lo + (hi - lo) / 2;
+    get_rec(2 * node, lo, mid, pair >> 32, vec);
+    get_rec(2 * node + 1, mid, hi, static_cast<uint32_t>(pair), vec);
+  }
+
+  void
+  int_vector_tree_db::get(unsigned index, int* vec) const
+  {
+    if (size_ <= 1)
+      {
+        if (size_)
+          vec[0] = tables_[1][index] >> 32;
+        return;
+      }
+    get_rec(1, 0, size_, index, vec);
+  }
+
+  size_t
+  int_vector_tree_db::pairs() const
+  {
+    size_t res = 0;
+    for (auto& t: tables_)
+      res += t.size();
+    return res;
+  }
+}
@@ -0,0 +1,111 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/misc/common.hh>
+#include <cstdint>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup misc_tools
+  /// \brief Store int vectors of fixed size as trees of shared pairs.
+  ///
+  /// Each vector is split recursively in two halves, down to single
+  /// values.  Each internal node of this tree is the pair formed by
+  /// the numbers of its two children, and is stored only once in a
+  /// table associated to its position in the tree.  A vector is then
+  /// represented by the number of its root pair, and vectors that
+  /// share subvectors (e.g., the states of a model that differ only
+  /// by a few variables) share the corresponding nodes.
+  ///
+  /// This is the tree compression of LTSmin.  Adding a vector costs
+  /// at most one pair in each of the \f$\log_2 n\f$ tables along
+  /// the modified paths, and vectors are numbered consecutively from
+  /// 0 in the order in which they were first inserted.  Nothing is
+  /// ever removed.
+  class SPOT_API int_vector_tree_db final
+  {
+  public:
+    /// Prepare a database for vectors of \a vector_size ints.
+    explicit int_vector_tree_db(unsigned vector_size);
+
+    /// \brief Store the vector \a vec and return its number.
+    ///
+    /// If the vector was already stored, its previous number is
+    /// returned.  An std::runtime_error is thrown if a table
+    /// overflows.
+    unsigned insert(const int* vec);
+
+    /// Retrieve the vector numbered \a index into \a vec.
+    void get(unsigned index, int* vec) const;
+
+    /// The size of the vectors.
+    unsigned vector_size() const
+    {
+      return size_;
+    }
+
+    /// The number of distinct vectors stored.
+    unsigned count() const
+    {
+      return tables_[1].size();
+    }
+
+    /// The number of pairs stored in all tables.
+    size_t pairs() const;
+
+  private:
+    // Open-addressing hash table of pairs, numbered by insertion
+    // order.
+    class pair_table final
+    {
+    public:
+      unsigned find_or_insert(uint64_t pair);
+
+      uint64_t operator[](unsigned index) const
+      {
+        return pairs_[index];
+      }
+
+      unsigned size() const
+      {
+        return pairs_.size();
+      }
+
+    private:
+      void grow();
+
+      std::vector<uint64_t> pairs_;
+      std::vector<unsigned> buckets_; // 0 when empty, index + 1 otherwise
+    };
+
+    unsigned insert_rec(unsigned node, unsigned lo, unsigned hi,
+                        const int* vec);
+    void get_rec(unsigned node, unsigned lo, unsigned hi,
+                 unsigned index, int* vec) const;
+
+    unsigned size_;
+    // Table of each internal node of the tree, numbered as in a
+    // binary heap: the root is 1, and the children of node k are
+    // 2k and 2k+1.
+    std::vector<pair_table> tables_;
+  };
+}
@@ -0,0 +1,480 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <cstring>
+#include <strings.h>
+#include <spot/parsetl/parsedecl.hh>
+
+// This is a recursive-descent parser for the subset of the infix
+// syntax that is used by most LTL formulas: atomic propositions
+// (bare or double-quoted), constants, parentheses, the Boolean
+// operators, and X, F, G, U, R, W, M in their ASCII spellings.
+//
+// It has to build exactly the same formula as parsetl.yy.  This
+// includes creating the subformulas in the same order, because the
+// operands of commutative operators are sorted by creation order.
+// Therefore the lexer below mimics the longest-match rules of
+// scantl.ll, including its two start conditions (INITIAL and
+// not_prop), and the operators are given the same precedence and
+// associativity as in parsetl.yy.
+//
+// Anything else (syntax errors, SERE or PSL operators, comments,
+// Wring's =0/=1 suffixes, non-ASCII operators, ...) causes the
+// parser to give up and return nullptr, so that the caller can use
+// the Bison parser, which will report errors properly.
+
+namespace
+{
+  using spot::formula;
+  using spot::op;
+
+  class fast_parser final
+  {
+  public:
+    fast_parser(const std::string& str, spot::environment& env)
+      : s_(str.c_str()), end_(s_ + str.size()), env_(env)
+    {
+    }
+
+    formula parse()
+    {
+      next();
+      formula res = parse_expr(1);
+      if (tok_ != tok_end)
+        return nullptr;
+      return res;
+    }
+
+  private:
+    enum token { tok_end, tok_unsupported,
+                 tok_ap, tok_true, tok_false, tok_par_open, tok_par_close,
+                 tok_not, tok_f, tok_g, tok_x,
+                 // binary operators, by increasing precedence
+                 tok_implies, tok_equiv, tok_or, tok_xor, tok_and,
+                 tok_star, tok_u, tok_r, tok_w, tok_m };
+
+    // Bison's stack is larger, but we do not want to exhaust ours.
+    // Deeper formulas are left to the Bison parser.
+    static constexpr unsigned max_depth = 2000;
+
+    const char* s_;
+    const char* end_;
+    spot::environment& env_;
+    token tok_;
+    std::string ap_;
+    bool not_prop_ = false;     // the not_prop start condition of scantl.ll
+    unsigned depth_ = 0;
+
+    static bool ap_char(char c)
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+        || (c >= '0' && c <= '9') || c == '_' || c == '.';
+    }
+
+    static bool is_space(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool is_fgx(char c)
+    {
+      return c == 'F' || c == 'G' || c == 'X';
+    }
+
+    void set(token t, unsigned len)
+    {
+      tok_ = t;
+      s_ += len;
+      not_prop_ = false;
+    }
+
+    // Read a word that starts like an atomic proposition.  Several
+    // rules of scantl.ll can match here, so we compute the length
+    // of each possible match, and keep the longest (or the first
+    // one in case of a tie).
+    void word()
+    {
+      unsigned run = 0;
+      while (s_ + run < end_ && ap_char(s_[run]))
+        ++run;
+      token best = tok_unsupported;
+      unsigned best_len = 0;
+      auto candidate = [&](token t, unsigned len)
+        {
+          if (len > best_len)
+            {
+              best = t;
+              best_len = len;
+            }
+        };
+      if (run >= 4 && !strncasecmp(s_, "true", 4))
+        candidate(tok_true, 4);
+      if (run >= 5 && !strncasecmp(s_, "false", 5))
+        candidate(tok_false, 5);
+      if (run >= 11 && !strncmp(s_, "first_match", 11))
+        candidate(tok_unsupported, 11);
+      if (run >= 3 && !strncmp(s_, "xor", 3))
+        candidate(tok_xor, 3);
+      char c = *s_;
+      switch (c)
+        {
+        case 'F':
+          candidate(tok_f, 1);
+          break;
+        case 'G':
+          candidate(tok_g, 1);
+          break;
+        case 'X':
+          candidate(tok_x, 1);
+          break;
+        case 'U':
+          candidate(tok_u, 1);
+          break;
+        case 'R':
+        case 'V':
+          candidate(tok_r, 1);
+          break;
+        case 'W':
+          candidate(tok_w, 1);
+          break;
+        case 'M':
+          candidate(tok_m, 1);
+          break;
+        default:
+          break;
+        }
+      unsigned ap_len = 0;
+      if (!not_prop_)
+        {
+          if (!is_fgx(c) || (run >= 2 && s_[1] >= '0' && s_[1] <= '9'))
+            ap_len = run;
+        }
+      else if (!is_fgx(c) && !strchr("MRUVW", c))
+        {
+          ap_len = (run >= 2 && !is_fgx(s_[1])) ? run : 1;
+        }
+      if (ap_len > best_len)
+        {
+          ap_.assign(s_, ap_len);
+          s_ += ap_len;
+          tok_ = tok_ap;
+          not_prop_ = true;
+          return;
+        }
+      // X[n], F[n:m], and G[n:m] are left to the Bison parser, but
+      // X[]f is just X(G(f)).
+      if (best_len == 1 && is_fgx(c))
+        {
+          const char* p = s_ + 1;
+          while (p < end_ && is_space(*p))
+            ++p;
+          if (p < end_ && *p == '[' && (p + 1 == end_ || p[1] != ']'))
+            best = tok_unsupported;
+        }
+      set(best, best_len);
+    }
+
+    void string()
+    {
+      ap_.clear();
+      const char* p = s_ + 1;
+      for (;;)
+        {
+          if (p == end_)
+            {
+              tok_ = tok_unsupported;   // unclosed string
+              return;
+            }
+          char c = *p++;
+          if (c == '"')
+            break;
+          if (c == '\\')
+            {
+              if (p == end_ || *p == '\n' || *p == '\r')
+                {
+                  tok_ = tok_unsupported;
+                  return;
+                }
+              c = *p++;
+            }
+          ap_ += c;
+        }
+      s_ = p;
+      tok_ = tok_ap;
+      not_prop_ = true;
+    }
+
+    bool at(unsigned offset, const char* str) const
+    {
+      unsigned len = strlen(str);
+      return s_ + offset + len <= end_ && !strncmp(s_ + offset, str, len);
+    }
+
+    void next()
+    {
+      while (s_ < end_ && is_space(*s_))
+        ++s_;
+      if (s_ == end_)
+        {
+          tok_ = tok_end;
+          return;
+        }
+      switch (*s_)
+        {
+        case '(':
+          if (at(1, ")"))
+            set(tok_x, 2);
+          else
+            set(tok_par_open, 1);
+          return;
+        case ')':
+          set(tok_par_close, 1);
+          not_prop_ = true;
+          return;
+        case '!':
+        case '~':
+          set(tok_not, 1);
+          return;
+        case '0':
+          set(tok_false, 1);
+          return;
+        case '1':
+          set(tok_true, 1);
+          return;
+        case '"':
+          string();
+          return;
+        case '|':
+          if (at(1, "|"))
+            set(tok_or, 2);
+          else if (at(1, "-") || at(1, "="))
+            set(tok_unsupported, 0); // |-> and |=>
+          else
+            set(tok_or, 1);
+          return;
+        case '+':
+          set(tok_or, 1);
+          return;
+        case '\\':
+          if (at(1, "/"))
+            set(tok_or, 2);
+          else
+            set(tok_unsupported, 0);
+          return;
+        case '/':
+          if (at(1, "\\"))
+            set(tok_and, 2);
+          else
+            set(tok_unsupported, 0); // comments
+          return;
+        case '&':
+          set(tok_and, at(1, "&") ? 2 : 1);
+          return;
+        case '*':
+          set(tok_star, 1);
+          return;
+        case '^':
+          set(tok_xor, 1);
+          return;
+        case '-':
+          if (at(1, ">"))
+            set(tok_implies, 2);
+          else if (at(1, "->"))
+            set(tok_implies, 3);
+          else
+            set(tok_unsupported, 0);
+          return;
+        case '=':
+          if (at(1, ">"))
+            set(tok_implies, 2);
+          else
+            set(tok_unsupported, 0); // =0 and =1
+          return;
+        case '<':
+          if (at(1, "->"))
+            set(tok_equiv, 3);
+          else if (at(1, "-->"))
+            set(tok_equiv, 4);
+          else if (at(1, "=>"))
+            set(tok_equiv, 3);
+          else if (at(1, ">") && !at(2, "-") && !at(2, "="))
+            set(tok_f, 2);
+          else
+            set(tok_unsupported, 0);
+          return;
+        case '[':
+          if (at(1, "]") && !at(2, "-") && !at(2, "="))
+            set(tok_g, 2);
+          else
+            set(tok_unsupported, 0);
+          return;
+        default:
+          if (ap_char(*s_) && !(*s_ >= '0' && *s_ <= '9'))
+            word();
+          else
+            set(tok_unsupported, 0);
+          return;
+        }
+    }
+
+    static unsigned precedence(token t)
+    {
+      switch (t)
+        {
+        case tok_implies:
+        case tok_equiv:
+          return 1;
+        case tok_or:
+          return 2;
+        case tok_xor:
+          return 3;
+        case tok_and:
+          return 4;
+        case tok_star:
+          return 5;
+        case tok_u:
+        case tok_r:
+        case tok_w:
+        case tok_m:
+          return 6;
+        default:
+          return 0;
+        }
+    }
+
+    static formula binop(token t, formula&& left, formula&& right)
+    {
+      switch (t)
+        {
+        case tok_implies:
+          return formula::binop(op::Implies, std::move(left),
+                                std::move(right));
+        case tok_equiv:
+          return formula::binop(op::Equiv, std::move(left),
+                                std::move(right));
+        case tok_or:
+          return formula::multop(op::Or, {std::move(left),
+                                          std::move(right)});
+        case tok_xor:
+          return formula::binop(op::Xor, std::move(left),
+                                std::move(right));
+        case tok_and:
+        case tok_star:
+          return formula::multop(op::And, {std::move(left),
+                                           std::move(right)});
+        case tok_u:
+          return formula::binop(op::U, std::move(left), std::move(right));
+        case tok_r:
+          return formula::binop(op::R, std::move(left), std::move(right));
+        case tok_w:
+          return formula::binop(op::W, std::move(left), std::move(right));
+        case tok_m:
+          return formula::binop(op::M, std::move(left), std::move(right));
+        default:
+          SPOT_UNREACHABLE();
+        }
+      return nullptr;
+    }
+
+    // Precedence climbing: parse operators whose precedence is at
+    // least min_prec.  Like in Bison, the left operand of an
+    // operator is built before its right operand.
+    formula parse_expr(unsigned min_prec)
+    {
+      if (SPOT_UNLIKELY(++depth_ > max_depth))
+        return nullptr;
+      formula left = parse_unary();
+      while (left)
+        {
+          token t = tok_;
+          unsigned prec = precedence(t);
+          if (prec < min_prec)
+            break;
+          next();
+          // ->, <->, U, R, W, M are right-associative.
+          bool right_assoc = prec == 1 || prec == 6;
+          formula right = parse_expr(right_assoc ? prec : prec + 1);
+          if (!right)
+            return nullptr;
+          left = binop(t, std::move(left), std::move(right));
+        }
+      --depth_;
+      return left;
+    }
+
+    formula parse_unary()
+    {
+      op o;
+      switch (tok_)
+        {
+        case tok_not:
+          o = op::Not;
+          break;
+        case tok_f:
+          o = op::F;
+          break;
+        case tok_g:
+          o = op::G;
+          break;
+        case tok_x:
+          o = op::X;
+          break;
+        case tok_ap:
+          {
+            formula res = env_.require(ap_);
+            next();
+            return res;
+          }
+        case tok_true:
+          next();
+          return formula::tt();
+        case tok_false:
+          next();
+          return formula::ff();
+        case tok_par_open:
+          {
+            next();
+            formula res = parse_expr(1);
+            if (!res || tok_ != tok_par_close)
+              return nullptr;
+            next();
+            return res;
+          }
+        default:
+          return nullptr;
+        }
+      // Unary operators bind more tightly than all binary operators.
+      if (SPOT_UNLIKELY(++depth_ > max_depth))
+        return nullptr;
+      next();
+      formula res = parse_unary();
+      --depth_;
+      if (!res)
+        return nullptr;
+      return formula::unop(o, std::move(res));
+    }
+  };
+}
+
+spot::formula
+fast_parse_infix_psl(const std::string& str, spot::environment& env)
+{
+  return fast_parser(str, env).parse();
+}
@@ -33,3 +33,8 @@ YY_DECL;
 
 void flex_set_buffer(const std::string& buf, int start_tok, bool lenient);
 void flex_unset_buffer();
+
+// Parse the common subset of the infix syntax without Bison.
+// Return nullptr on anything unusual, including syntax errors.
+spot::formula fast_parse_infix_psl(const std::string& str,
+                                   spot::environment& env);
@@ -1105,6 +1105,14 @@ namespace spot
 		  bool debug, bool lenient)
   {
     parsed_formula result(ltl_string);
+    // Most inputs are plain LTL formulas without syntax errors.
+    // Parse them without firing the whole Bison/Flex machinery.
+    if (!debug && !lenient)
+      {
+	result.f = fast_parse_infix_psl(ltl_string, env);
+	if (result.f)
+	  return result;
+      }
     flex_set_buffer(ltl_string,
 		    tlyy::parser::token::START_LTL,
 		    lenient);
@@ -0,0 +1,123 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/priv/forkworkers.hh>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace spot
+{
+  namespace
+  {
+    struct worker_report
+    {
+      int worker;
+      int status;
+    };
+
+    [[noreturn]] static void
+    throw_errno(const char* caller, const char* what)
+    {
+      throw std::runtime_error(std::string(caller) + ": " + what + ": "
+                               + strerror(errno));
+    }
+  }
+
+  void fork_workers(const char* caller, unsigned workers, int failed,
+                    const std::function<int(unsigned)>& work,
+                    const std::function<bool(unsigned, int)>& decide)
+  {
+    int fds[2];
+    if (pipe(fds))
+      throw_errno(caller, "pipe() failed");
+    // Do not let the children output what is buffered.
+    std::cout.flush();
+    std::cerr.flush();
+    fflush(nullptr);
+
+    std::vector<pid_t> pids;
+    pids.reserve(workers);
+    // Killing all workers is our cancellation mechanism.
+    auto cancel = [&]()
+      {
+        for (pid_t pid: pids)
+          kill(pid, SIGKILL);
+        for (pid_t pid: pids)
+          while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR)
+            continue;
+      };
+
+    for (unsigned i = 0; i < workers; ++i)
+      {
+        pid_t pid = fork();
+        if (pid < 0)
+          {
+            int saved = errno;
+            close(fds[0]);
+            close(fds[1]);
+            cancel();
+            errno = saved;
+            throw_errno(caller, "fork() failed");
+          }
+        if (pid == 0)
+          {
+            close(fds[0]);
+            worker_report r = { static_cast<int>(i), failed };
+            try
+              {
+                r.status = work(i);
+              }
+            catch (...)
+              {
+              }
+            // Reports are smaller than PIPE_BUF, so they are written
+            // atomically.
+            ssize_t w;
+            while ((w = write(fds[1], &r, sizeof r)) < 0 && errno == EINTR)
+              continue;
+            // Do not run destructors or flush buffers of the parent.
+            _exit(w == sizeof r ? 0 : 1);
+          }
+        pids.push_back(pid);
+      }
+    close(fds[1]);
+
+    // The end of the file means all workers have terminated.
+    for (;;)
+      {
+        worker_report r;
+        ssize_t n = read(fds[0], &r, sizeof r);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n != sizeof r || decide(r.worker, r.status))
+          break;
+      }
+    close(fds[0]);
+    cancel();
+  }
+}
@@ -0,0 +1,42 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <functional>
+
+namespace spot
+{
+  /// \brief Run \a workers functions in child processes, and collect
+  /// their results in the parent.
+  ///
+  /// Worker \a i runs `work(i)` in a process started with fork(),
+  /// and sends the returned integer to the parent, or \a failed if
+  /// `work(i)` throws.  The parent calls `decide(i, status)` for each
+  /// report, in the order in which they arrive, until it returns true
+  /// or all the workers have terminated.  The remaining workers are
+  /// then killed.  Processes are used instead of threads because BDDs
+  /// and formulas cannot be shared between threads.
+  ///
+  /// An std::runtime_error whose message starts with \a caller is
+  /// thrown if a pipe or a process cannot be created.
+  void fork_workers(const char* caller, unsigned workers, int failed,
+                    const std::function<int(unsigned)>& work,
+                    const std::function<bool(unsigned, int)>& decide);
+}
@@ -29,7 +29,9 @@
 
 #include <spot/taalgos/emptinessta.hh>
 #include <spot/misc/memusage.hh>
+#include <spot/priv/forkworkers.hh>
 #include <cstdlib>
+#include <stdexcept>
 #include <spot/twa/bddprint.hh>
 
 namespace spot
@@ -49,6 +51,23 @@ namespace spot
   ta_check::check(bool disable_second_pass,
       bool disable_heuristic_for_livelock_detection)
   {
+    bool activate_heuristic = !disable_heuristic_for_livelock_detection
+        && (is_full_2_pass_ == disable_second_pass);
+    bool livelock_acceptance_states_found = false;
+
+    if (first_pass(activate_heuristic, livelock_acceptance_states_found))
+      return true;
+
+    if (disable_second_pass || !livelock_acceptance_states_found)
+      return false;
+
+    return livelock_detection(a_);
+  }
+
+  bool
+  ta_check::first_pass(bool activate_heuristic,
+      bool& livelock_acceptance_states_found)
+  {
 
     // We use five main data in this algorithm:
 
@@ -79,11 +98,6 @@ namespace spot
 
     std::stack<spot::state*> livelock_roots;
 
-    bool livelock_acceptance_states_not_found = true;
-
-    bool activate_heuristic = !disable_heuristic_for_livelock_detection
-        && (is_full_2_pass_ == disable_second_pass);
-
     // Setup depth-first search from initial states.
     auto& ta_ = a_->get_ta();
     auto& kripke_ = a_->get_kripke();
@@ -142,7 +156,7 @@ namespace spot
                 if (a_->is_livelock_accepting_state(curr)
                     && !a_->is_accepting_state(curr))
                   {
-                    livelock_acceptance_states_not_found = false;
+                    livelock_acceptance_states_found = true;
                     trace << "PASS 1 : livelock accepting state found\n";
                   }
 
@@ -335,11 +349,7 @@ namespace spot
       }
 
     clear(h, todo, ta_init_it_);
-
-    if (disable_second_pass || livelock_acceptance_states_not_found)
-      return false;
-
-    return livelock_detection(a_);
+    return false;
   }
 
   bool
@@ -565,6 +575,52 @@ namespace spot
     return false;
   }
 
+  namespace
+  {
+    // What a worker of ta_check::parallel_check() reports to the
+    // parent process.  NO_RUN means that the worker found no run of
+    // the kind it was looking for.
+    enum ta_worker_status { found, empty, no_run, failed };
+  }
+
+  bool
+  ta_check::parallel_check(bool disable_heuristic_for_livelock_detection)
+  {
+    bool activate_heuristic = !disable_heuristic_for_livelock_detection
+        && !is_full_2_pass_;
+
+    // The language is empty if the first pass says so, or if both
+    // passes found no run.  A failed worker does not stop the
+    // collection, since the other one may still decide the result.
+    int res = -1;
+    unsigned no_runs = 0;
+    fork_workers("ta_check::parallel_check", 2, failed,
+                 [&](unsigned i)
+                 {
+                   if (i == 1)
+                     return livelock_detection(a_) ? found : no_run;
+                   // The first pass.  If it did not see any
+                   // livelock-accepting state, the second pass cannot
+                   // find anything either.
+                   bool livelock_acceptance_states_found = false;
+                   if (first_pass(activate_heuristic,
+                                  livelock_acceptance_states_found))
+                     return found;
+                   return livelock_acceptance_states_found ? no_run : empty;
+                 },
+                 [&](unsigned, int status)
+                 {
+                   if (status == found || status == empty)
+                     res = status == found;
+                   else if (status == no_run && ++no_runs == 2)
+                     res = 0;
+                   return res >= 0;
+                 });
+    if (res < 0)
+      throw std::runtime_error("ta_check::parallel_check: a worker failed");
+    return res;
+  }
+
   void
   ta_check::clear(hash_type& h, std::stack<pair_state_iter> todo,
       std::queue<const spot::state*> init_states)
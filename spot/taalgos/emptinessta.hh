@@ -98,6 +98,22 @@ namespace spot
     check(bool disable_second_pass = false,
           bool disable_heuristic_for_livelock_detection = false);
 
+    /// \brief Same as check(), but run the two passes in parallel.
+    ///
+    /// The first pass and the second pass (livelock_detection()) are
+    /// run by two child processes, because BDDs cannot be shared
+    /// between threads.  The check stops as soon as one of them finds
+    /// an accepting run, or as soon as the first pass reports that
+    /// the product has no livelock-accepting state.  This is faster
+    /// than check() when the second pass is needed, and the
+    /// statistics of this object are not updated.
+    ///
+    /// An std::runtime_error is thrown if a process cannot be started,
+    /// or if a worker fails (for instance by running out of memory)
+    /// and the other worker does not decide the result.
+    bool
+    parallel_check(bool disable_heuristic_for_livelock_detection = false);
+
     /// \brief Check whether the product automaton contains
     /// a livelock-accepting run
     /// Return false if the product automaton accepts no livelock-accepting run,
@@ -110,6 +126,15 @@ namespace spot
     print_stats(std::ostream& os) const;
 
   protected:
+    /// \brief The first pass of check().
+    ///
+    /// Return true if an accepting run was found, and set \a
+    /// livelock_acceptance_states_found if some livelock-accepting
+    /// state that is not Buchi-accepting was visited.
+    bool
+    first_pass(bool activate_heuristic,
+               bool& livelock_acceptance_states_found);
+
     void
     clear(hash_type& h, std::stack<pair_state_iter> todo, std::queue<
         const spot::state*> init_set);
@@ -0,0 +1,290 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/tl/binary.hh>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace spot
+{
+  namespace
+  {
+    // The header starts with a null byte so that binary streams can
+    // be told apart from text files of formulas.  The last byte is
+    // the version of the format.
+    static const char header[] = { '\0', 'S', 'P', 'O', 'T', 'L', 'T', 'L',
+                                   '\1' };
+
+    // Record tags.
+    enum : char { ap_record = 'a', node_record = 'n', formula_record = 'f' };
+
+    static const unsigned max_op =
+#if SPOT_HAS_STRONG_X
+      static_cast<unsigned>(op::strong_X);
+#else
+      static_cast<unsigned>(op::first_match);
+#endif
+
+    [[noreturn]] static void
+    malformed(const char* what)
+    {
+      throw std::runtime_error(std::string("binary_formula_reader: ")
+                               + what);
+    }
+  }
+
+  binary_formula_writer::binary_formula_writer(std::ostream& os)
+    : os_(os)
+  {
+  }
+
+  // Integers are written as little-endian base-128 numbers.
+  void
+  binary_formula_writer::put(unsigned v)
+  {
+    while (v >= 0x80)
+      {
+        os_.put(static_cast<char>(v | 0x80));
+        v >>= 7;
+      }
+    os_.put(static_cast<char>(v));
+  }
+
+  unsigned
+  binary_formula_writer::node(formula f)
+  {
+    auto it = ids_.find(f.id());
+    if (it != ids_.end())
+      return it->second;
+    if (f.is(op::ap))
+      {
+        const std::string& name = f.ap_name();
+        os_.put(ap_record);
+        put(name.size());
+        os_.write(name.data(), name.size());
+      }
+    else
+      {
+        // Children must be defined before their parent.
+        unsigned n = f.size();
+        std::vector<unsigned> children;
+        children.reserve(n);
+        for (auto c: f)
+          children.push_back(node(c));
+        os_.put(node_record);
+        os_.put(static_cast<char>(f.kind()));
+        if (f.is(op::Star, op::FStar))
+          {
+            os_.put(static_cast<char>(f.min()));
+            os_.put(static_cast<char>(f.max()));
+          }
+        put(n);
+        for (unsigned c: children)
+          put(c);
+      }
+    unsigned id = ids_.size();
+    ids_.emplace(f.id(), id);
+    return id;
+  }
+
+  void
+  binary_formula_writer::write(formula f)
+  {
+    if (!header_written_)
+      {
+        os_.write(header, sizeof(header));
+        header_written_ = true;
+      }
+    unsigned id = node(f);
+    os_.put(formula_record);
+    put(id);
+  }
+
+  binary_formula_reader::binary_formula_reader(std::istream& is)
+    : is_(is)
+  {
+  }
+
+  bool
+  binary_formula_reader::is_binary(std::istream& is)
+  {
+    return is.peek() == '\0';
+  }
+
+  unsigned
+  binary_formula_reader::get()
+  {
+    unsigned res = 0;
+    for (unsigned shift = 0; shift < 32; shift += 7)
+      {
+        int c = is_.get();
+        if (c == std::char_traits<char>::eof())
+          malformed("unexpected end of stream");
+        res |= static_cast<unsigned>(c & 0x7f) << shift;
+        if (!(c & 0x80))
+          return res;
+      }
+    malformed("integer too large");
+  }
+
+  const formula&
+  binary_formula_reader::ref()
+  {
+    unsigned id = get();
+    if (id >= nodes_.size())
+      malformed("reference to an undefined node");
+    return nodes_[id];
+  }
+
+  formula
+  binary_formula_reader::next()
+  {
+    if (!header_read_)
+      {
+        char buf[sizeof(header)];
+        if (!is_.read(buf, sizeof(buf)))
+          {
+            if (is_.gcount() == 0)
+              return nullptr;
+            malformed("truncated header");
+          }
+        if (!std::equal(buf, buf + sizeof(buf) - 1, header))
+          malformed("not a binary formula stream");
+        if (buf[sizeof(buf) - 1] != header[sizeof(header) - 1])
+          malformed("unsupported version");
+        header_read_ = true;
+      }
+    for (;;)
+      {
+        int tag = is_.get();
+        switch (tag)
+          {
+          case std::char_traits<char>::eof():
+            return nullptr;
+          case formula_record:
+            return ref();
+          case ap_record:
+            {
+              std::string name(get(), '\0');
+              if (!is_.read(&name[0], name.size()))
+                malformed("unexpected end of stream");
+              nodes_.emplace_back(formula::ap(name));
+              break;
+            }
+          case node_record:
+            {
+              int k = is_.get();
+              if (k < 0 || static_cast<unsigned>(k) > max_op
+                  || static_cast<op>(k) == op::ap)
+                malformed("unknown operator");
+              op o = static_cast<op>(k);
+              uint8_t min = 0;
+              uint8_t max = 0;
+              if (o == op::Star || o == op::FStar)
+                {
+                  int mi = is_.get();
+                  int ma = is_.get();
+                  if (ma < 0)
+                    malformed("unexpected end of stream");
+                  min = mi;
+                  max = ma;
+                }
+              unsigned n = get();
+              std::vector<formula> c;
+              c.reserve(n);
+              for (unsigned i = 0; i < n; ++i)
+                c.push_back(ref());
+              unsigned expected = n;
+              formula f;
+              switch (o)
+                {
+                case op::ff:
+                  expected = 0;
+                  f = formula::ff();
+                  break;
+                case op::tt:
+                  expected = 0;
+                  f = formula::tt();
+                  break;
+                case op::eword:
+                  expected = 0;
+                  f = formula::eword();
+                  break;
+                case op::ap:
+                  SPOT_UNREACHABLE();
+                case op::Not:
+                case op::X:
+#if SPOT_HAS_STRONG_X
+                case op::strong_X:
+#endif
+                case op::F:
+                case op::G:
+                case op::Closure:
+                case op::NegClosure:
+                case op::NegClosureMarked:
+                case op::first_match:
+                  expected = 1;
+                  if (n == expected)
+                    f = formula::unop(o, std::move(c[0]));
+                  break;
+                case op::Xor:
+                case op::Implies:
+                case op::Equiv:
+                case op::U:
+                case op::R:
+                case op::W:
+                case op::M:
+                case op::EConcat:
+                case op::EConcatMarked:
+                case op::UConcat:
+                  expected = 2;
+                  if (n == expected)
+                    f = formula::binop(o, std::move(c[0]), std::move(c[1]));
+                  break;
+                case op::Or:
+                case op::OrRat:
+                case op::And:
+                case op::AndRat:
+                case op::AndNLM:
+                case op::Concat:
+                case op::Fusion:
+                  if (n < 2)
+                    malformed("n-ary operator with less than two operands");
+                  f = formula::multop(o, std::move(c));
+                  break;
+                case op::Star:
+                case op::FStar:
+                  expected = 1;
+                  if (n == expected)
+                    f = formula::bunop(o, std::move(c[0]), min, max);
+                  break;
+                }
+              if (n != expected)
+                malformed("wrong number of operands");
+              nodes_.emplace_back(std::move(f));
+              break;
+            }
+          default:
+            malformed("unknown record");
+          }
+      }
+  }
+}
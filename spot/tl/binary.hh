@@ -0,0 +1,91 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/tl/formula.hh>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+namespace spot
+{
+  /// \addtogroup tl_io
+  /// @{
+
+  /// \brief Write formulas in Spot's binary formula stream format.
+  ///
+  /// The stream starts with a short header, followed by records
+  /// that either define an atomic proposition, define a node from
+  /// its operator and the numbers of previously defined nodes, or
+  /// output a formula given its node number.  Each subformula is
+  /// therefore written only once for the whole stream, however many
+  /// formulas share it, and reading the stream back with
+  /// binary_formula_reader does not involve any parsing.
+  ///
+  /// The writer remembers the node numbers of the subformulas it has
+  /// written using their formula::id(), without keeping them alive.
+  /// A subformula that is destroyed and later rebuilt will therefore
+  /// be written again.
+  class SPOT_API binary_formula_writer final
+  {
+  public:
+    explicit binary_formula_writer(std::ostream& os);
+
+    /// Append \a f to the stream.
+    void write(formula f);
+
+  private:
+    unsigned node(formula f);
+    void put(unsigned v);
+
+    std::ostream& os_;
+    std::unordered_map<size_t, unsigned> ids_;
+    bool header_written_ = false;
+  };
+
+  /// \brief Read formulas in Spot's binary formula stream format.
+  ///
+  /// \see binary_formula_writer
+  class SPOT_API binary_formula_reader final
+  {
+  public:
+    explicit binary_formula_reader(std::istream& is);
+
+    /// \brief Whether the next bytes of \a is look like the start of
+    /// a binary formula stream.
+    static bool is_binary(std::istream& is);
+
+    /// \brief Read the next formula.
+    ///
+    /// Return nullptr at the end of the stream.  An
+    /// std::runtime_error is thrown if the stream is malformed.
+    formula next();
+
+  private:
+    unsigned get();
+    const formula& ref();
+
+    std::istream& is_;
+    std::vector<formula> nodes_;
+    bool header_read_ = false;
+  };
+
+  /// @}
+}
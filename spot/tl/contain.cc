@@ -29,17 +29,19 @@
 #include <spot/misc/hash.hh>
 #include <spot/priv/robin_hood.hh>
 #include <spot/twaalgos/ltl2tgba_fm.hh>
+#include <spot/twaalgos/sccfilter.hh>
 
 namespace spot
 {
   struct language_containment_checker::record_
   {
     const_twa_graph_ptr translation;
+    bool empty;
     typedef robin_hood::unordered_flat_map<const record_*, bool> incomp_map;
     incomp_map incompatible;
 
-    record_(const_twa_graph_ptr&& trans) noexcept
-      : translation(std::move(trans))
+    record_(const_twa_graph_ptr&& trans)
+      : translation(std::move(trans)), empty(translation->is_empty())
     {
     }
   };
@@ -75,6 +77,8 @@ namespace spot
   bool
   language_containment_checker::incompatible_(record_* l, record_* g)
   {
+    if (l->empty || g->empty)
+      return true;
     record_::incomp_map::const_iterator i = l->incompatible.find(g);
     if (i != l->incompatible.end())
       return i->second;
@@ -120,6 +124,25 @@ namespace spot
   }
 
 
+  std::vector<bool>
+  language_containment_checker::contained(formula l,
+                                          const std::vector<formula>& gs)
+  {
+    std::vector<bool> res;
+    res.reserve(gs.size());
+    // If L(l) is empty, it is contained in everything, and there is
+    // no need to translate the negations of the gs.
+    if (register_formula_(l)->empty)
+      {
+        res.resize(gs.size(), true);
+        return res;
+      }
+    for (auto& g: gs)
+      res.push_back(contained(l, g));
+    return res;
+  }
+
+
   // Check whether L(!l) is a subset of L(g).
   bool
   language_containment_checker::neg_contained(formula l,
@@ -154,6 +177,9 @@ namespace spot
 
     auto e = ltl_to_tgba_fm(f, dict_, exprop_, symb_merge_,
                             branching_postponement_, fair_loop_approx_);
-    return &translated_->emplace(f, std::move(e)).first->second;
+    // The translation will be used in many products.  Removing its
+    // useless SCCs once makes all of them smaller.
+    const_twa_graph_ptr t = scc_filter(e);
+    return &translated_->emplace(f, std::move(t)).first->second;
   }
 }
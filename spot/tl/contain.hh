@@ -24,6 +24,7 @@
 
 #include <spot/tl/formula.hh>
 #include <spot/twa/bdddict.hh>
+#include <vector>
 
 namespace spot
 {
@@ -50,6 +51,13 @@ namespace spot
 
     /// Check whether L(l) is a subset of L(g).
     bool contained(formula l, formula g);
+    /// \brief Check whether L(l) is a subset of L(g) for each formula
+    /// g of \a gs.
+    ///
+    /// The i-th Boolean of the result corresponds to the i-th formula
+    /// of \a gs.  All checks reuse the translation of \a l, and
+    /// the negations of \a gs are not translated if L(l) is empty.
+    std::vector<bool> contained(formula l, const std::vector<formula>& gs);
     /// Check whether L(!l) is a subset of L(g).
     bool neg_contained(formula l, formula g);
     /// Check whether L(l) is a subset of L(!g).
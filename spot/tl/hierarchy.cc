@@ -40,7 +40,8 @@ namespace spot
   {
     static bool
     cobuchi_realizable(spot::formula f,
-                       const const_twa_graph_ptr& aut)
+                       const const_twa_graph_ptr& aut,
+                       const_twa_graph_ptr not_aut = nullptr)
     {
       // Find which algorithm must be performed between nsa_to_nca() and
       // dnf_to_nca(). Throw an exception if none of them can be performed.
@@ -54,7 +55,8 @@ namespace spot
 
       // If !f is a DBA, it belongs to the recurrence class, which means
       // f belongs to the persistence class (is cobuchi_realizable).
-      twa_graph_ptr not_aut = ltl_to_tgba_fm(formula::Not(f), aut->get_dict());
+      if (!not_aut)
+        not_aut = ltl_to_tgba_fm(formula::Not(f), aut->get_dict());
       not_aut = scc_filter(not_aut);
       if (is_universal(not_aut))
         return true;
@@ -151,7 +153,8 @@ namespace spot
   }
 
   bool
-  is_persistence(formula f, twa_graph_ptr aut, prcheck algo)
+  is_persistence(formula f, twa_graph_ptr aut, prcheck algo,
+                 twa_graph_ptr aut_neg)
   {
     if (f.is_syntactic_persistence())
       return true;
@@ -170,11 +173,15 @@ namespace spot
       {
       case prcheck::via_CoBuchi:
         return cobuchi_realizable(f, aut ? aut :
-                                  ltl_to_tgba_fm(f, make_bdd_dict(), true));
+                                  ltl_to_tgba_fm(f, aut_neg ?
+                                                 aut_neg->get_dict() :
+                                                 make_bdd_dict(), true),
+                                  aut_neg);
 
       case prcheck::via_Rabin:
       case prcheck::via_Parity:
-        return detbuchi_realizable(ltl_to_tgba_fm(formula::Not(f),
+        return detbuchi_realizable(aut_neg ? aut_neg :
+                                   ltl_to_tgba_fm(formula::Not(f),
                                                   make_bdd_dict(), true));
 
       case prcheck::Auto:
@@ -185,7 +192,8 @@ namespace spot
   }
 
   bool
-  is_recurrence(formula f, twa_graph_ptr aut, prcheck algo)
+  is_recurrence(formula f, twa_graph_ptr aut, prcheck algo,
+                twa_graph_ptr aut_neg)
   {
     if (f.is_syntactic_recurrence())
       return true;
@@ -204,8 +212,11 @@ namespace spot
       {
       case prcheck::via_CoBuchi:
         return cobuchi_realizable(formula::Not(f),
-                                  ltl_to_tgba_fm(formula::Not(f),
-                                                 make_bdd_dict(), true));
+                                  aut_neg ? aut_neg :
+                                  ltl_to_tgba_fm(formula::Not(f), aut ?
+                                                 aut->get_dict() :
+                                                 make_bdd_dict(), true),
+                                  aut);
 
       case prcheck::via_Rabin:
       case prcheck::via_Parity:
@@ -228,10 +239,12 @@ namespace spot
 
   // This private function is defined in minimize.cc for technical
   // reasons.
-  SPOT_LOCAL bool is_wdba_realizable(formula f, twa_graph_ptr aut = nullptr);
+  SPOT_LOCAL bool is_wdba_realizable(formula f, twa_graph_ptr aut = nullptr,
+                                     const_twa_graph_ptr aut_neg = nullptr);
 
   bool
-  is_obligation(formula f, twa_graph_ptr aut, ocheck algo)
+  is_obligation(formula f, twa_graph_ptr aut, ocheck algo,
+                twa_graph_ptr aut_neg)
   {
     if (algo == ocheck::Auto)
       {
@@ -263,13 +276,13 @@ namespace spot
     switch (algo)
       {
       case ocheck::via_WDBA:
-        return is_wdba_realizable(f, aut);
+        return is_wdba_realizable(f, aut, aut_neg);
       case ocheck::via_CoBuchi:
-        return (is_persistence(f, aut, prcheck::via_CoBuchi)
-                && is_recurrence(f, aut, prcheck::via_CoBuchi));
+        return (is_persistence(f, aut, prcheck::via_CoBuchi, aut_neg)
+                && is_recurrence(f, aut, prcheck::via_CoBuchi, aut_neg));
       case ocheck::via_Rabin:
-        return (is_persistence(f, aut, prcheck::via_Rabin)
-                && is_recurrence(f, aut, prcheck::via_Rabin));
+        return (is_persistence(f, aut, prcheck::via_Rabin, aut_neg)
+                && is_recurrence(f, aut, prcheck::via_Rabin, aut_neg));
       case ocheck::Auto:
         SPOT_UNREACHABLE();
       }
@@ -283,7 +296,12 @@ namespace spot
       return 'B';
     auto dict = make_bdd_dict();
     auto aut = ltl_to_tgba_fm(f, dict, true);
-    auto min = minimize_obligation(aut, f);
+    // The automaton for !f is needed by all the following checks,
+    // unless f is obviously an obligation.  Build it once.
+    twa_graph_ptr neg = nullptr;
+    if (!minimize_obligation_garanteed_to_work(aut, f))
+      neg = ltl_to_tgba_fm(formula::Not(f), dict, true);
+    auto min = minimize_obligation(aut, f, neg);
     if (aut != min) // An obligation.
       {
         scc_info si(min);
@@ -297,9 +315,9 @@ namespace spot
           return s ? 'S' : 'O';
       }
     // Not an obligation.  Could by 'P', 'R', or 'T'.
-    if (is_recurrence(f, aut))
+    if (is_recurrence(f, aut, prcheck::Auto, neg))
       return 'R';
-    if (is_persistence(f, aut))
+    if (is_persistence(f, aut, prcheck::Auto, neg))
       return 'P';
     return 'T';
   }
@@ -59,10 +59,13 @@ namespace spot
   /// \param f the formula to check.
   /// \param aut the corresponding automaton (not required).
   /// \param algo the algorithm to use (see enum class prcheck).
+  /// \param aut_neg an automaton for the negation of \a f (not
+  /// required).
   SPOT_API bool
   is_persistence(formula f,
                  twa_graph_ptr aut = nullptr,
-                 prcheck algo = prcheck::Auto);
+                 prcheck algo = prcheck::Auto,
+                 twa_graph_ptr aut_neg = nullptr);
 
   /// \ingroup tl_hier
   /// \brief Return true if \a f represents a recurrence property.
@@ -72,10 +75,13 @@ namespace spot
   /// \param f the formula to check.
   /// \param aut the corresponding automaton (not required).
   /// \param algo the algorithm to use (see enum class prcheck).
+  /// \param aut_neg an automaton for the negation of \a f (not
+  /// required).
   SPOT_API bool
   is_recurrence(formula f,
                 twa_graph_ptr aut = nullptr,
-                prcheck algo = prcheck::Auto);
+                prcheck algo = prcheck::Auto,
+                twa_graph_ptr aut_neg = nullptr);
 
   /// Enum used to change the behavior of is_obligation().
   enum class ocheck
@@ -94,8 +100,13 @@ namespace spot
   /// \param f the formula to check.
   /// \param aut the corresponding automaton (not required).
   /// \param algo the algorithm to use.
+  /// \param aut_neg an automaton for the negation of \a f (not
+  /// required).
   ///
-  /// \a aut is constructed from f if not supplied.
+  /// \a aut is constructed from f if not supplied.  Supplying \a aut
+  /// and \a aut_neg avoids translating \a f or its negation when
+  /// they are already available, for instance because multiple
+  /// properties of the same formula are checked.
   ///
   /// If \a algo is ocheck::via_WDBA, aut is converted into a WDBA
   /// which is then checked for equivalence with aut.  If \a algo is
@@ -109,7 +120,8 @@ namespace spot
   SPOT_API bool
   is_obligation(formula f,
                 twa_graph_ptr aut = nullptr,
-                ocheck algo = ocheck::Auto);
+                ocheck algo = ocheck::Auto,
+                twa_graph_ptr aut_neg = nullptr);
 
   /// \ingroup tl_hier
   /// \brief Return the class of \a f in the temporal hierarchy of Manna
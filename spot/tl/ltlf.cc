@@ -19,14 +19,22 @@
 
 #include "config.h"
 #include <spot/tl/ltlf.hh>
+#include <unordered_map>
 
 namespace spot
 {
   namespace
   {
-    formula from_ltlf_aux(formula f, formula alive)
+    typedef std::unordered_map<formula, formula> f2f_cache;
+
+    formula from_ltlf_rec(formula f, formula alive, f2f_cache& cache);
+
+    formula from_ltlf_aux(formula f, formula alive, f2f_cache& cache)
     {
-      auto t = [&alive] (formula f) { return from_ltlf_aux(f, alive); };
+      auto t = [&alive, &cache] (formula f)
+        {
+          return from_ltlf_rec(f, alive, cache);
+        };
       switch (auto o = f.kind())
         {
         case op::strong_X:
@@ -59,6 +67,19 @@ namespace spot
           return f.map(t);
         }
     }
+
+    // Shared subformulas are translated only once.
+    formula from_ltlf_rec(formula f, formula alive, f2f_cache& cache)
+    {
+      if (f.size() == 0)
+        return f;
+      auto entry = cache.emplace(f, nullptr);
+      if (!entry.second)
+        return entry.first->second;
+      formula& res = entry.first->second;
+      formula tmp = from_ltlf_aux(f, alive, cache);
+      return res = tmp;
+    }
   }
 
   formula from_ltlf(formula f, const char* alive)
@@ -68,7 +89,8 @@ namespace spot
     auto al = ((*alive == '!')
                ? formula::Not(formula::ap(alive + 1))
                : formula::ap(alive));
-    return formula::And({from_ltlf_aux(f, al), al,
+    f2f_cache cache;
+    return formula::And({from_ltlf_rec(f, al, cache), al,
                          formula::U(al, formula::G(formula::Not(al)))});
   }
 }
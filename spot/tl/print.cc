@@ -26,6 +26,7 @@
 #include <ctype.h>
 #include <ostream>
 #include <cstring>
+#include <unordered_map>
 #include <spot/tl/unabbrev.hh>
 #include <spot/tl/print.hh>
 #include <spot/misc/escape.hh>
@@ -369,21 +370,129 @@ namespace spot
       return nullptr;
     }
 
+    // Append-only output into a string.  Printing each token through
+    // std::ostream is much slower.
+    class str_out final
+    {
+    public:
+      explicit str_out(std::string& s)
+        : s_(s)
+      {
+      }
+
+      str_out& operator<<(const char* str)
+      {
+        s_ += str;
+        return *this;
+      }
+
+      str_out& operator<<(const std::string& str)
+      {
+        s_ += str;
+        return *this;
+      }
+
+      str_out& operator<<(char c)
+      {
+        s_ += c;
+        return *this;
+      }
+
+      str_out& operator<<(unsigned n)
+      {
+        char buf[12];
+        char* p = buf + sizeof(buf);
+        do
+          *--p = '0' + n % 10;
+        while (n /= 10);
+        s_.append(p, buf + sizeof(buf));
+        return *this;
+      }
+
+    private:
+      std::string& s_;
+    };
+
+    typedef std::unordered_map<size_t, std::string> ap_cache;
+
+    static void
+    print_ap(str_out& os, const std::string& str,
+             const char** kw, bool full_parent)
+    {
+      if (!is_bare_word(str.c_str()))
+        {
+          // Spin 6 supports atomic propositions such as (a == 0)
+          // as long as they are enclosed in parentheses.
+          if (kw == sclatex_kw  || kw == latex_kw)
+            {
+              std::ostringstream tmp;
+              escape_latex(tmp << "``\\mathit{", str)
+                << "}\\textrm{''}";
+              os << tmp.str();
+            }
+          else if (kw != spin_kw)
+            {
+              std::ostringstream tmp;
+              escape_str(tmp << '"', str) << '"';
+              os << tmp.str();
+            }
+          else if (!full_parent)
+            os << '(' << str << ')';
+          else
+            os << str;
+        }
+      else
+        {
+          if (kw == latex_kw || kw == sclatex_kw)
+            {
+              size_t s = str.size();
+              while (str[s - 1] >= '0' && str[s - 1] <= '9')
+                {
+                  --s;
+                  // bare words cannot start with digits
+                  assert(s != 0);
+                }
+              if (s > 1)
+                os << "\\mathit{";
+              // Bare words only contain alphanumeric characters, '.',
+              // and '_'.  Only the latter needs escaping.
+              for (size_t i = 0; i < s; ++i)
+                if (str[i] == '_')
+                  os << "\\_";
+                else
+                  os << str[i];
+              if (s > 1)
+                os << '}';
+              if (s != str.size())
+                os << "_{"
+                   << str.substr(s)
+                   << '}';
+            }
+          else
+            {
+              os << str;
+            }
+        }
+      if (kw == wring_kw)
+        os << "=1";
+    }
+
     class to_string_visitor final
     {
     public:
-      to_string_visitor(std::ostream& os,
+      to_string_visitor(std::string& out,
                         bool full_parent = false,
                         bool ratexp = false,
-                        const char** kw = spot_kw)
-        : os_(os), top_level_(true),
+                        const char** kw = spot_kw,
+                        ap_cache* aps = nullptr)
+        : os_(out), top_level_(true),
         full_parent_(full_parent), in_ratexp_(ratexp),
-        kw_(kw)
+        kw_(kw), aps_(aps)
         {
         }
 
       void
-        openp() const
+        openp()
       {
         if (in_ratexp_)
           emit(KOpenSERE);
@@ -392,7 +501,7 @@ namespace spot
       }
 
       void
-        closep() const
+        closep()
       {
         if (in_ratexp_)
           emit(KCloseSERE);
@@ -400,8 +509,8 @@ namespace spot
           os_ << ')';
       }
 
-      std::ostream&
-        emit(int symbol) const
+      str_out&
+        emit(int symbol)
       {
         return os_ << kw_[symbol];
       }
@@ -446,52 +555,20 @@ namespace spot
             emit(KEmptyWord);
             break;
           case op::ap:
-            {
-              const std::string& str = f.ap_name();
-              if (!is_bare_word(str.c_str()))
-                {
-                  // Spin 6 supports atomic propositions such as (a == 0)
-                  // as long as they are enclosed in parentheses.
-                  if (kw_ == sclatex_kw  || kw_ == latex_kw)
-                    escape_latex(os_ << "``\\mathit{", str)
-                      << "}\\textrm{''}";
-                  else if (kw_ != spin_kw)
-                    escape_str(os_ << '"', str) << '"';
-                  else if (!full_parent_)
-                    os_ << '(' << str << ')';
-                  else
-                    os_ << str;
-                }
-              else
-                {
-                  if (kw_ == latex_kw || kw_ == sclatex_kw)
-                    {
-                      size_t s = str.size();
-                      while (str[s - 1] >= '0' && str[s - 1] <= '9')
-                        {
-                          --s;
-                          // bare words cannot start with digits
-                          assert(s != 0);
-                        }
-                      if (s > 1)
-                        os_ << "\\mathit{";
-                      escape_latex(os_, str.substr(0, s));
-                      if (s > 1)
-                        os_ << '}';
-                      if (s != str.size())
-                        os_ << "_{"
-                            << str.substr(s)
-                            << '}';
-                    }
-                  else
-                    {
-                      os_ << str;
-                    }
-                }
-              if (kw_ == wring_kw)
-                os_ << "=1";
-
-            }
+            if (aps_)
+              {
+                auto p = aps_->emplace(f.id(), std::string());
+                if (p.second)
+                  {
+                    str_out tmp(p.first->second);
+                    print_ap(tmp, f.ap_name(), kw_, full_parent_);
+                  }
+                os_ << p.first->second;
+              }
+            else
+              {
+                print_ap(os_, f.ap_name(), kw_, full_parent_);
+              }
             break;
           case op::Not:
             {
@@ -878,29 +955,30 @@ namespace spot
       }
 
     protected:
-      std::ostream& os_;
+      str_out os_;
       bool top_level_;
       bool full_parent_;
       bool in_ratexp_;
       const char** kw_;
+      ap_cache* aps_;
     };
 
 
-    std::ostream&
-    printer_(std::ostream& os, formula f, bool full_parent,
-             bool ratexp, const char** kw)
+    std::string
+    str_(formula f, bool full_parent, bool ratexp, const char** kw)
     {
-      to_string_visitor v(os, full_parent, ratexp, kw);
+      std::string res;
+      to_string_visitor v(res, full_parent, ratexp, kw);
       v.visit(f);
-      return os;
+      return res;
     }
 
-    std::string
-    str_(formula f, bool full_parent, bool ratexp, const char** kw)
+    std::ostream&
+    printer_(std::ostream& os, formula f, bool full_parent,
+             bool ratexp, const char** kw)
     {
-      std::ostringstream os;
-      printer_(os, f, full_parent, ratexp, kw);
-      return os.str();
+      std::string res = str_(f, full_parent, ratexp, kw);
+      return os.write(res.data(), res.size());
     }
 
   } // anonymous
@@ -958,33 +1036,27 @@ namespace spot
   std::ostream&
   print_spin_ltl(std::ostream& os, formula f, bool full_parent)
   {
-    to_string_visitor v(os, full_parent, false, spin_kw);
-    v.visit(unabbreviate(f, "^MW"));
-    return os;
+    std::string res = str_spin_ltl(f, full_parent);
+    return os.write(res.data(), res.size());
   }
 
   std::string
   str_spin_ltl(formula f, bool full_parent)
   {
-    std::ostringstream os;
-    print_spin_ltl(os, f, full_parent);
-    return os.str();
+    return str_(unabbreviate(f, "^MW"), full_parent, false, spin_kw);
   }
 
   std::ostream&
   print_wring_ltl(std::ostream& os, formula f)
   {
-    to_string_visitor v(os, true, false, wring_kw);
-    v.visit(unabbreviate(f, "MW"));
-    return os;
+    std::string res = str_wring_ltl(f);
+    return os.write(res.data(), res.size());
   }
 
   std::string
   str_wring_ltl(formula f)
   {
-    std::ostringstream os;
-    print_wring_ltl(os, f);
-    return os.str();
+    return str_(unabbreviate(f, "MW"), true, false, wring_kw);
   }
 
   std::ostream&
@@ -1050,15 +1122,31 @@ namespace spot
       return true;
     }
 
+    static void
+    print_lbt_ap(str_out& os, const std::string& str)
+    {
+      if (!is_pnum(str.c_str()))
+        {
+          std::ostringstream tmp;
+          escape_str(tmp << '"', str) << '"';
+          os << tmp.str();
+        }
+      else
+        {
+          os << str;
+        }
+    }
+
     class lbt_visitor final
     {
     protected:
-      std::ostream& os_;
+      str_out os_;
       bool first_;
+      ap_cache* aps_;
     public:
 
-      lbt_visitor(std::ostream& os)
-        : os_(os), first_(true)
+      lbt_visitor(std::string& out, ap_cache* aps = nullptr)
+        : os_(out), first_(true), aps_(aps)
         {
         }
 
@@ -1080,14 +1168,21 @@ namespace spot
             os_ << 't';
             break;
           case op::ap:
-            {
-              const std::string& str = f.ap_name();
-              if (!is_pnum(str.c_str()))
-                escape_str(os_ << '"', str) << '"';
-              else
-                os_ << str;
-              break;
-            }
+            if (aps_)
+              {
+                auto p = aps_->emplace(f.id(), std::string());
+                if (p.second)
+                  {
+                    str_out tmp(p.first->second);
+                    print_lbt_ap(tmp, f.ap_name());
+                  }
+                os_ << p.first->second;
+              }
+            else
+              {
+                print_lbt_ap(os_, f.ap_name());
+              }
+            break;
           case op::Not:
             os_ << '!';
             break;
@@ -1161,17 +1256,92 @@ namespace spot
   std::ostream&
   print_lbt_ltl(std::ostream& os, formula f)
   {
-    assert(f.is_ltl_formula());
-    lbt_visitor v(os);
-    v.visit(f);
-    return os;
+    std::string res = str_lbt_ltl(f);
+    return os.write(res.data(), res.size());
   }
 
   std::string
   str_lbt_ltl(formula f)
   {
-    std::ostringstream os;
-    print_lbt_ltl(os, f);
-    return os.str();
+    assert(f.is_ltl_formula());
+    std::string res;
+    lbt_visitor v(res);
+    v.visit(f);
+    return res;
+  }
+
+  formula_print_buffer::formula_print_buffer(std::ostream& os, style s,
+                                             bool full_parent,
+                                             unsigned block_size)
+    : os_(os), style_(s), full_parent_(full_parent),
+      block_size_(block_size)
+  {
+    buf_.reserve(block_size + block_size / 4);
+  }
+
+  formula_print_buffer::~formula_print_buffer()
+  {
+    flush();
+  }
+
+  void
+  formula_print_buffer::flush()
+  {
+    os_.write(buf_.data(), buf_.size());
+    buf_.clear();
+  }
+
+  formula_print_buffer&
+  formula_print_buffer::operator<<(formula f)
+  {
+    if (style_ == lbt_ltl)
+      {
+        assert(f.is_ltl_formula());
+        lbt_visitor v(buf_, &aps_);
+        v.visit(f);
+      }
+    else
+      {
+        static const char** const kws[] =
+          {
+            spot_kw, spot_kw, utf8_kw, utf8_kw, spin_kw, wring_kw,
+            latex_kw, latex_kw, sclatex_kw, sclatex_kw,
+          };
+        bool ratexp = style_ == sere || style_ == utf8_sere
+          || style_ == latex_sere || style_ == sclatex_sere;
+        bool full_parent = full_parent_ || style_ == wring_ltl;
+        if (style_ == spin_ltl)
+          f = unabbreviate(f, "^MW");
+        else if (style_ == wring_ltl)
+          f = unabbreviate(f, "MW");
+        to_string_visitor v(buf_, full_parent, ratexp, kws[style_], &aps_);
+        v.visit(f);
+      }
+    flush_if_full();
+    return *this;
+  }
+
+  formula_print_buffer&
+  formula_print_buffer::operator<<(const std::string& str)
+  {
+    buf_ += str;
+    flush_if_full();
+    return *this;
+  }
+
+  formula_print_buffer&
+  formula_print_buffer::operator<<(const char* str)
+  {
+    buf_ += str;
+    flush_if_full();
+    return *this;
+  }
+
+  formula_print_buffer&
+  formula_print_buffer::operator<<(char c)
+  {
+    buf_ += c;
+    flush_if_full();
+    return *this;
   }
 }
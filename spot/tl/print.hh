@@ -24,6 +24,8 @@
 
 #include <spot/tl/formula.hh>
 #include <iosfwd>
+#include <string>
+#include <unordered_map>
 
 namespace spot
 {
@@ -217,5 +219,61 @@ namespace spot
   /// \param f The formula to translate.
   SPOT_API std::string
   str_lbt_ltl(formula f);
+
+#ifndef SWIG
+  /// \brief Buffered output of many formulas.
+  ///
+  /// Formulas and separators are appended to a contiguous buffer,
+  /// without going through std::ostream, and this buffer is written
+  /// to the output stream in blocks of at least \a block_size bytes,
+  /// or when flush() is called (at the latest, by the destructor).
+  ///
+  /// The representation of each atomic proposition is computed and
+  /// escaped only once, and cached for the lifetime of this object.
+  /// The output is identical to that of the corresponding print_*()
+  /// function.
+  class SPOT_API formula_print_buffer final
+  {
+  public:
+    /// The syntax to use, matching the print_*() functions.
+    enum style { psl, sere, utf8_psl, utf8_sere, spin_ltl, wring_ltl,
+                 latex_psl, latex_sere, sclatex_psl, sclatex_sere,
+                 lbt_ltl };
+
+    /// \brief Prepare to print formulas on \a os.
+    ///
+    /// \a full_parent is ignored for the wring_ltl and lbt_ltl styles.
+    formula_print_buffer(std::ostream& os, style s = psl,
+                         bool full_parent = false,
+                         unsigned block_size = 65536);
+    ~formula_print_buffer();
+
+    /// Append formula \a f, printed in the selected style.
+    formula_print_buffer& operator<<(formula f);
+    /// Append a string.
+    formula_print_buffer& operator<<(const std::string& str);
+    /// Append a string.
+    formula_print_buffer& operator<<(const char* str);
+    /// Append a character.
+    formula_print_buffer& operator<<(char c);
+
+    /// Write the buffered output to the output stream.
+    void flush();
+
+  private:
+    void flush_if_full()
+    {
+      if (buf_.size() >= block_size_)
+        flush();
+    }
+
+    std::ostream& os_;
+    style style_;
+    bool full_parent_;
+    unsigned block_size_;
+    std::string buf_;
+    std::unordered_map<size_t, std::string> aps_;
+  };
+#endif
   /// @}
 }
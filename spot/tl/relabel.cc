@@ -86,6 +86,7 @@ namespace spot
     public:
       typedef std::unordered_map<formula, formula> map;
       map newname;
+      map visited;              // results of visit(), for shared subformulas
       ap_generator* gen;
       relabeling_map* oldnames;
 
@@ -121,11 +122,18 @@ namespace spot
       {
         if (f.is(op::ap))
           return rename(f);
-        else
-          return f.map([this](formula f)
-                       {
-                         return this->visit(f);
-                       });
+        if (f.size() == 0)
+          return f;
+        auto entry = visited.emplace(f, nullptr);
+        if (!entry.second)
+          return entry.first->second;
+        // The reference stays valid even if visited is rehashed.
+        formula& res = entry.first->second;
+        formula tmp = f.map([this](formula f)
+                            {
+                              return this->visit(f);
+                            });
+        return res = tmp;
       }
 
     };
@@ -523,6 +531,18 @@ namespace spot
           return rename(f);
 
         unsigned sz = f.size();
+        if (sz == 0)
+          return f;
+        auto entry = visited.emplace(f, nullptr);
+        if (!entry.second)
+          return entry.first->second;
+        formula& res = entry.first->second;
+        return res = visit_children(f, sz);
+      }
+
+      formula
+      visit_children(formula f, unsigned sz)
+      {
         if (sz <= 2)
           return f.map([this](formula f)
                        {
@@ -601,16 +621,36 @@ namespace spot
     return rel.visit(f);
   }
 
+  namespace
+  {
+    typedef std::unordered_map<formula, formula> f2f_cache;
+
+    static formula
+    relabel_apply_rec(formula f, relabeling_map* m, f2f_cache& cache)
+    {
+      if (f.is(op::ap))
+        {
+          auto i = m->find(f);
+          if (i != m->end())
+            return i->second;
+          return f;
+        }
+      if (f.size() == 0)
+        return f;
+      auto entry = cache.emplace(f, nullptr);
+      if (!entry.second)
+        return entry.first->second;
+      formula& res = entry.first->second;
+      formula tmp = f.map(relabel_apply_rec, m, cache);
+      return res = tmp;
+    }
+  }
+
   formula
   relabel_apply(formula f, relabeling_map* m)
   {
-    if (f.is(op::ap))
-      {
-        auto i = m->find(f);
-        if (i != m->end())
-          return i->second;
-      }
-    return f.map(relabel_apply, m);
+    f2f_cache cache;
+    return relabel_apply_rec(f, m, cache);
   }
 
 }
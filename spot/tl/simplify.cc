@@ -34,8 +34,11 @@
 #include <spot/tl/length.hh>
 #include <spot/twa/formula2bdd.hh>
 #include <spot/misc/minato.hh>
+#include <spot/misc/hashfunc.hh>
+#include <algorithm>
 #include <cassert>
 #include <memory>
+#include <stdexcept>
 #include <unordered_set>
 #include <map>
 
@@ -45,14 +48,246 @@ namespace spot
 {
   typedef std::vector<formula> vec;
 
+  namespace
+  {
+    // A map from formulas to formulas, whose size can be bounded.
+    // When the limit is reached, entries are evicted using the
+    // "clock" (or second chance) algorithm: entries are stored in a
+    // circular buffer with a bit telling whether they have been used
+    // since the last time the hand passed over them, and the hand
+    // evicts the first entry whose bit is not set.
+    class f2f_cache final
+    {
+      struct entry
+      {
+        formula value;
+        unsigned slot;
+      };
+      robin_hood::unordered_map<formula, entry> map_;
+      std::vector<std::pair<formula, bool>> ring_; // key, referenced
+      unsigned hand_ = 0;
+      unsigned long hits_ = 0;
+      unsigned long misses_ = 0;
+      unsigned long evictions_ = 0;
+
+    public:
+      // Return nullptr if f is not in the cache.
+      formula
+      find(formula f)
+      {
+        auto i = map_.find(f);
+        if (i == map_.end())
+          {
+            ++misses_;
+            return nullptr;
+          }
+        ++hits_;
+        ring_[i->second.slot].second = true;
+        return i->second.value;
+      }
+
+      // Insert a new entry.  If limit is not 0 and the cache already
+      // holds that many entries, another entry is evicted first.
+      void
+      insert(formula f, formula value, unsigned limit)
+      {
+        auto i = map_.find(f);
+        if (i != map_.end())
+          {
+            i->second.value = value;
+            return;
+          }
+        unsigned slot;
+        if (limit == 0 || ring_.size() < limit)
+          {
+            slot = ring_.size();
+            ring_.emplace_back(f, false);
+          }
+        else
+          {
+            unsigned n = ring_.size();
+            for (;;)
+              {
+                if (hand_ >= n)
+                  hand_ = 0;
+                if (!ring_[hand_].second)
+                  break;
+                ring_[hand_].second = false;
+                ++hand_;
+              }
+            slot = hand_++;
+            map_.erase(ring_[slot].first);
+            ++evictions_;
+            ring_[slot] = {f, false};
+          }
+        map_.emplace(f, entry{value, slot});
+      }
+
+      size_t
+      size() const
+      {
+        return map_.size();
+      }
+
+      void
+      clear()
+      {
+        map_.clear();
+        ring_.clear();
+        hand_ = 0;
+        hits_ = misses_ = evictions_ = 0;
+      }
+
+      void
+      print_stats(std::ostream& os) const
+      {
+        os << size() << " entries";
+        if (hits_ || misses_)
+          os << ", " << hits_ << " hits, " << misses_ << " misses";
+        if (evictions_)
+          os << ", " << evictions_ << " evictions";
+        os << '\n';
+      }
+    };
+
+    // Results of syntactic implications.  This is an open-addressing
+    // hash table keyed on the identifiers of the two formulas.  Both
+    // directions of the implication are stored in the same entry,
+    // which is keyed on the formula with the smaller identifier
+    // first.  Since the table cannot evict individual entries, it is
+    // emptied when it reaches the size limit.
+    class syntimpl_cache final
+    {
+      struct entry
+      {
+        formula lo;             // nullptr for an empty slot
+        formula hi;
+        // bit 0: lo=>hi is known, bit 1: lo=>hi
+        // bit 2: hi=>lo is known, bit 3: hi=>lo
+        unsigned char bits;
+      };
+      std::vector<entry> table_;
+      size_t size_ = 0;
+      unsigned long hits_ = 0;
+      unsigned long misses_ = 0;
+      unsigned long evictions_ = 0;
+
+      static size_t
+      hash(const formula& lo, const formula& hi)
+      {
+        return wang32_hash(lo.id() ^ wang32_hash(hi.id()));
+      }
+
+      // Find the slot of (lo, hi), or the empty slot where it should
+      // be inserted.
+      entry&
+      slot(const formula& lo, const formula& hi)
+      {
+        size_t mask = table_.size() - 1;
+        size_t i = hash(lo, hi) & mask;
+        for (;;)
+          {
+            entry& e = table_[i];
+            if (!e.lo || (e.lo == lo && e.hi == hi))
+              return e;
+            i = (i + 1) & mask;
+          }
+      }
+
+      void
+      grow()
+      {
+        std::vector<entry> old(std::max<size_t>(64, table_.size() * 2));
+        std::swap(old, table_);
+        for (auto& e: old)
+          if (e.lo)
+            {
+              entry& n = slot(e.lo, e.hi);
+              n = std::move(e);
+            }
+      }
+
+    public:
+      // Return 1 if f=>g is known, 0 if it is known not to hold, and
+      // -1 if it is not known.
+      int
+      find(const formula& f, const formula& g)
+      {
+        if (size_ == 0)
+          {
+            ++misses_;
+            return -1;
+          }
+        bool swap = g.id() < f.id();
+        entry& e = swap ? slot(g, f) : slot(f, g);
+        unsigned bits = e.bits >> (swap ? 2 : 0);
+        if (!e.lo || !(bits & 1))
+          {
+            ++misses_;
+            return -1;
+          }
+        ++hits_;
+        return (bits >> 1) & 1;
+      }
+
+      void
+      insert(const formula& f, const formula& g, bool res, unsigned limit)
+      {
+        if (limit && size_ >= limit)
+          {
+            evictions_ += size_;
+            for (auto& e: table_)
+              e = entry{};
+            size_ = 0;
+          }
+        if (2 * (size_ + 1) > table_.size())
+          grow();
+        bool swap = g.id() < f.id();
+        const formula& lo = swap ? g : f;
+        const formula& hi = swap ? f : g;
+        entry& e = slot(lo, hi);
+        if (!e.lo)
+          {
+            e.lo = lo;
+            e.hi = hi;
+            e.bits = 0;
+            ++size_;
+          }
+        e.bits |= (1 | (res << 1)) << (swap ? 2 : 0);
+      }
+
+      size_t
+      size() const
+      {
+        return size_;
+      }
+
+      void
+      clear()
+      {
+        table_.clear();
+        size_ = 0;
+        hits_ = misses_ = evictions_ = 0;
+      }
+
+      void
+      print_stats(std::ostream& os) const
+      {
+        os << size() << " entries";
+        if (hits_ || misses_)
+          os << ", " << hits_ << " hits, " << misses_ << " misses";
+        if (evictions_)
+          os << ", " << evictions_ << " evictions";
+        os << '\n';
+      }
+    };
+  }
+
   // The name of this class is public, but not its contents.
   class tl_simplifier_cache final
   {
-    typedef robin_hood::unordered_map<formula, formula> f2f_map;
     typedef robin_hood::unordered_map<formula, bdd> f2b_map;
     typedef robin_hood::unordered_map<int, formula> b2f_map;
-    typedef std::pair<formula, formula> pairf;
-    typedef std::map<pairf, bool> syntimpl_cache_t;
   public:
     bdd_dict_ptr dict;
     tl_simplifier_options options;
@@ -79,14 +314,29 @@ namespace spot
     void
     print_stats(std::ostream& os) const
     {
-      os << "simplified formulae:    " << simplified_.size() << " entries\n"
-         << "negative normal form:   " << nenoform_.size() << " entries\n"
-         << "syntactic implications: " << syntimpl_.size() << " entries\n"
-         << "boolean to bdd:         " << as_bdd_.size() << " entries\n"
-         << "star normal form:       " << snf_cache_.size() << " entries\n"
-         << "boolean isop:           " << bool_isop_.size() << " entries\n"
-         << "as dnf:                 " << as_dnf_.size() << " entries\n"
-         << "as cnf:                 " << as_cnf_.size() << " entries\n";
+      simplified_.print_stats(os << "simplified formulae:    ");
+      nenoform_.print_stats(os << "negative normal form:   ");
+      syntimpl_.print_stats(os << "syntactic implications: ");
+      os << "boolean to bdd:         " << as_bdd_.size() << " entries\n"
+         << "star normal form:       " << snf_cache_.size() << " entries\n";
+      bool_isop_.print_stats(os << "boolean isop:           ");
+      as_dnf_.print_stats(os << "as dnf:                 ");
+      as_cnf_.print_stats(os << "as cnf:                 ");
+    }
+
+    void
+    clear()
+    {
+      clear_as_bdd_cache();
+      lcc.clear();
+      simplified_.clear();
+      as_dnf_.clear();
+      as_cnf_.clear();
+      nenoform_.clear();
+      syntimpl_.clear();
+      snf_cache_.clear();
+      snfb_cache_.clear();
+      bool_isop_.clear();
     }
 
     void
@@ -217,21 +467,19 @@ namespace spot
 
     formula as_dnf(formula f)
     {
-      auto i = as_dnf_.find(f);
-      if (i != as_dnf_.end())
-        return i->second;
+      if (formula r = as_dnf_.find(f))
+        return r;
       formula r = as_xnf(f, false);
-      as_dnf_[f] = r;
+      as_dnf_.insert(f, r, options.cache_size_limit);
       return r;
     }
 
     formula as_cnf(formula f)
     {
-      auto i = as_cnf_.find(f);
-      if (i != as_cnf_.end())
-        return i->second;
+      if (formula r = as_cnf_.find(f))
+        return r;
       formula r = as_xnf(f, true);
-      as_cnf_[f] = r;
+      as_cnf_.insert(f, r, options.cache_size_limit);
       return r;
     }
 
@@ -240,16 +488,13 @@ namespace spot
     formula
     lookup_nenoform(formula f)
     {
-      f2f_map::const_iterator i = nenoform_.find(f);
-      if (i == nenoform_.end())
-        return nullptr;
-      return i->second;
+      return nenoform_.find(f);
     }
 
     void
     cache_nenoform(formula orig, formula nenoform)
     {
-      nenoform_[orig] = nenoform;
+      nenoform_.insert(orig, nenoform, options.cache_size_limit);
     }
 
     // Return true iff the option set (syntactic implication
@@ -356,16 +601,13 @@ namespace spot
     formula
     lookup_simplified(formula f)
     {
-      f2f_map::const_iterator i = simplified_.find(f);
-      if (i == simplified_.end())
-        return nullptr;
-      return i->second;
+      return simplified_.find(f);
     }
 
     void
     cache_simplified(formula orig, formula simplified)
     {
-      simplified_[orig] = simplified;
+      simplified_.insert(orig, simplified, options.cache_size_limit);
     }
 
     formula
@@ -384,27 +626,26 @@ namespace spot
     formula
     boolean_to_isop(formula f)
     {
-      f2f_map::const_iterator it = bool_isop_.find(f);
-      if (it != bool_isop_.end())
-        return it->second;
+      if (formula res = bool_isop_.find(f))
+        return res;
 
       assert(f.is_boolean());
       formula res = bdd_to_formula(as_bdd(f), dict);
-      bool_isop_[f] = res;
+      bool_isop_.insert(f, res, options.cache_size_limit);
       return res;
     }
 
   private:
     f2b_map as_bdd_;
     b2f_map bdd_to_f_;
-    f2f_map simplified_;
-    f2f_map as_dnf_;
-    f2f_map as_cnf_;
-    f2f_map nenoform_;
-    syntimpl_cache_t syntimpl_;
+    f2f_cache simplified_;
+    f2f_cache as_dnf_;
+    f2f_cache as_cnf_;
+    f2f_cache nenoform_;
+    syntimpl_cache syntimpl_;
     snf_cache snf_cache_;
     snf_cache snfb_cache_;
-    f2f_map bool_isop_;
+    f2f_cache bool_isop_;
   };
 
 
@@ -4027,12 +4268,9 @@ namespace spot
       return false;
 
     // Cache lookup
-    {
-      pairf p(f, g);
-      syntimpl_cache_t::const_iterator i = syntimpl_.find(p);
-      if (i != syntimpl_.end())
-        return i->second;
-    }
+    int known = syntimpl_.find(f, g);
+    if (known >= 0)
+      return known;
 
     bool result;
 
@@ -4042,12 +4280,9 @@ namespace spot
       result = syntactic_implication_aux(f, g);
 
     // Cache result
-    {
-      pairf p(f, g);
-      syntimpl_[p] = result;
-      // std::cerr << str_psl(f) << (result ? " ==> " : " =/=> ")
-      //           << str_psl(g) << std::endl;
-    }
+    syntimpl_.insert(f, g, result, options.cache_size_limit);
+    // std::cerr << str_psl(f) << (result ? " ==> " : " =/=> ")
+    //           << str_psl(g) << std::endl;
 
     return result;
   }
@@ -4077,19 +4312,25 @@ namespace spot
   // tl_simplifier
 
   tl_simplifier::tl_simplifier(const bdd_dict_ptr& d)
+    : cache_(std::make_shared<tl_simplifier_cache>(d))
   {
-    cache_ = new tl_simplifier_cache(d);
   }
 
   tl_simplifier::tl_simplifier(const tl_simplifier_options& opt,
                                  bdd_dict_ptr d)
+    : cache_(std::make_shared<tl_simplifier_cache>(d, opt))
   {
-    cache_ = new tl_simplifier_cache(d, opt);
+  }
+
+  tl_simplifier::tl_simplifier(const tl_simplifier_cache_ptr& cache)
+    : cache_(cache)
+  {
+    if (SPOT_UNLIKELY(!cache))
+      throw std::runtime_error("tl_simplifier() requires a non-null cache");
   }
 
   tl_simplifier::~tl_simplifier()
   {
-    delete cache_;
   }
 
   formula
@@ -4097,7 +4338,7 @@ namespace spot
   {
     if (!f.is_in_nenoform())
       f = negative_normal_form(f, false);
-    return simplify_recursively(f, cache_);
+    return simplify_recursively(f, cache_.get());
   }
 
   tl_simplifier_options&
@@ -4109,7 +4350,7 @@ namespace spot
   formula
   tl_simplifier::negative_normal_form(formula f, bool negated)
   {
-    return nenoform_rec(f, negated, cache_, false);
+    return nenoform_rec(f, negated, cache_.get(), false);
   }
 
   bool
@@ -4161,6 +4402,12 @@ namespace spot
     return cache_->dict;
   }
 
+  tl_simplifier_cache_ptr
+  tl_simplifier::get_cache() const
+  {
+    return cache_;
+  }
+
   void
   tl_simplifier::print_stats(std::ostream& os) const
   {
@@ -4177,9 +4424,6 @@ namespace spot
   void
   tl_simplifier::clear_caches()
   {
-    tl_simplifier_cache* c =
-      new tl_simplifier_cache(get_dict(), cache_->options);
-    std::swap(c, cache_);
-    delete c;
+    cache_->clear();
   }
 }
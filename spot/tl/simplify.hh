@@ -23,6 +23,7 @@
 #include <bddx.h>
 #include <spot/twa/bdddict.hh>
 #include <iosfwd>
+#include <memory>
 
 namespace spot
 {
@@ -93,10 +94,16 @@ namespace spot
     // &,|, and X operators.  Only rewrite Xor and Equiv under
     // temporal operators.
     bool keep_top_xor;
+    // Maximum number of entries kept in each of the caches of
+    // simplified formulas, negative normal forms, and Boolean
+    // normal forms.  When a cache is full, the entries that have
+    // not been used recently are evicted.  0 means no limit.
+    unsigned cache_size_limit = 0;
   };
 
   // fwd declaration to hide technical details.
   class tl_simplifier_cache;
+  typedef std::shared_ptr<tl_simplifier_cache> tl_simplifier_cache_ptr;
 
   /// \ingroup tl_rewriting
   /// \brief Rewrite or simplify \a f in various ways.
@@ -106,6 +113,22 @@ namespace spot
     tl_simplifier(const bdd_dict_ptr& dict = make_bdd_dict());
     tl_simplifier(const tl_simplifier_options& opt,
                    bdd_dict_ptr dict = make_bdd_dict());
+
+#ifndef SWIG
+    /// \brief Build a simplifier that uses the caches of another
+    /// simplifier.
+    ///
+    /// \a cache should have been obtained with get_cache().  All the
+    /// simplifiers built on the same cache share their options, their
+    /// bdd_dict, and the results they have cached.  This makes it
+    /// possible to keep a warm cache across multiple simplifiers
+    /// (e.g., one per request of a long-running service), while
+    /// tl_simplifier_options::cache_size_limit bounds its size.
+    ///
+    /// Like the rest of the library, a cache should not be used by
+    /// multiple threads concurrently.
+    tl_simplifier(const tl_simplifier_cache_ptr& cache);
+#endif
     ~tl_simplifier();
 
     /// Simplify the formula \a f (using options supplied to the
@@ -116,7 +139,8 @@ namespace spot
     /// The simplifier options.
     ///
     /// Those should can still be changed before the first formula is
-    /// simplified.
+    /// simplified.  They are shared by all simplifiers using the same
+    /// cache.
     tl_simplifier_options& options();
 #endif
 
@@ -179,12 +203,21 @@ namespace spot
 
     /// \brief Clear all caches.
     ///
-    /// This empties all the cache used by the simplifier.
+    /// This empties all the cache used by the simplifier, and
+    /// therefore also those of the simplifiers sharing them.
     void clear_caches();
 
     /// Return the bdd_dict used.
     bdd_dict_ptr get_dict() const;
 
+#ifndef SWIG
+    /// \brief Return the caches used by this simplifier.
+    ///
+    /// The result can be passed to the constructor of another
+    /// simplifier to share these caches.
+    tl_simplifier_cache_ptr get_cache() const;
+#endif
+
     /// Cached version of spot::star_normal_form().
     formula star_normal_form(formula f);
 
@@ -195,11 +228,14 @@ namespace spot
     /// arguments.
     formula boolean_to_isop(formula f);
 
-    /// Dump statistics about the caches.
+    /// \brief Dump statistics about the caches.
+    ///
+    /// This includes the number of hits, misses, and evictions of
+    /// the bounded caches.
     void print_stats(std::ostream& os) const;
 
   private:
-    tl_simplifier_cache* cache_;
+    tl_simplifier_cache_ptr cache_;
     // Copy disallowed.
     tl_simplifier(const tl_simplifier&) = delete;
     void operator=(const tl_simplifier&) = delete;
@@ -0,0 +1,313 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/twa/letters.hh>
+#include <stdexcept>
+
+namespace spot
+{
+  namespace
+  {
+    // bit_masks[b] has bit i set iff bit b of i is set.
+    static const letter_masks::mask_t bit_masks[letter_masks::max_aps] =
+      {
+        0xAAAAAAAAAAAAAAAAULL,
+        0xCCCCCCCCCCCCCCCCULL,
+        0xF0F0F0F0F0F0F0F0ULL,
+        0xFF00FF00FF00FF00ULL,
+        0xFFFF0000FFFF0000ULL,
+        0xFFFFFFFF00000000ULL,
+      };
+
+    // Fill vars with the variables of aps, and var_pos with their
+    // positions.
+    static void
+    read_vars(const char* who, const bdd& aps, unsigned max_aps,
+              std::vector<int>& vars, std::vector<int>& var_pos)
+    {
+      bdd a = aps;
+      while (a != bddtrue)
+        {
+          if (SPOT_UNLIKELY(a == bddfalse || bdd_low(a) != bddfalse))
+            throw std::runtime_error(std::string(who) + "() expects a "
+                                     "conjunction of positive variables");
+          vars.push_back(bdd_var(a));
+          a = bdd_high(a);
+        }
+      if (SPOT_UNLIKELY(vars.size() > max_aps))
+        throw std::runtime_error(std::string(who) + "() supports at most "
+                                 + std::to_string(max_aps)
+                                 + " atomic propositions");
+      if (!vars.empty())
+        var_pos.resize(vars.back() + 1, -1);
+      for (unsigned i = 0, n = vars.size(); i < n; ++i)
+        var_pos[vars[i]] = i;
+    }
+  }
+
+  letter_masks::letter_masks(const bdd& aps)
+  {
+    read_vars("letter_masks", aps, max_aps, vars_, var_pos_);
+    unsigned nl = num_letters();
+    all_ = nl == 64 ? ~mask_t(0) : (mask_t(1) << nl) - 1;
+  }
+
+  // The letters in which the variable at position pos is true.
+  letter_masks::mask_t
+  letter_masks::var_mask(unsigned pos) const
+  {
+    return bit_masks[vars_.size() - 1 - pos] & all_;
+  }
+
+  letter_masks::mask_t
+  letter_masks::as_mask(const bdd& label)
+  {
+    if (label == bddtrue)
+      return all_;
+    if (label == bddfalse)
+      return 0;
+    auto it = mask_cache_.find(label);
+    if (it != mask_cache_.end())
+      return it->second;
+    int v = bdd_var(label);
+    if (SPOT_UNLIKELY((unsigned) v >= var_pos_.size() || var_pos_[v] < 0))
+      throw std::runtime_error("letter_masks: label uses a variable "
+                               "that is not in the alphabet");
+    // Shannon expansion
+    mask_t vm = var_mask(var_pos_[v]);
+    mask_t res = (vm & as_mask(bdd_high(label)))
+      | (~vm & all_ & as_mask(bdd_low(label)));
+    mask_cache_.emplace(label, res);
+    return res;
+  }
+
+  bdd
+  letter_masks::as_bdd(mask_t m)
+  {
+    m &= all_;
+    if (m == 0)
+      return bddfalse;
+    if (m == all_)
+      return bddtrue;
+    auto it = bdd_cache_.find(m);
+    if (it != bdd_cache_.end())
+      return it->second;
+    // Split on the first variable (in BDD order) on which m depends.
+    // The two cofactors are computed so that they do not depend on
+    // that variable anymore.
+    unsigned n = vars_.size();
+    for (unsigned pos = 0; pos < n; ++pos)
+      {
+        unsigned shift = 1U << (n - 1 - pos);
+        mask_t vm = var_mask(pos);
+        mask_t hi = m & vm;
+        hi |= hi >> shift;
+        mask_t lo = m & ~vm;
+        lo |= lo << shift;
+        if (hi == lo)
+          continue;
+        bdd res = bdd_ite(bdd_ithvar(vars_[pos]), as_bdd(hi), as_bdd(lo));
+        bdd_cache_.emplace(m, res);
+        return res;
+      }
+    SPOT_UNREACHABLE();
+    return bddfalse;
+  }
+
+  std::vector<letter_masks::mask_t>
+  letter_masks::edge_masks(const const_twa_graph_ptr& aut)
+  {
+    auto& ev = aut->edge_vector();
+    unsigned n = ev.size();
+    std::vector<mask_t> res(n, 0);
+    for (unsigned i = 1; i < n; ++i)
+      res[i] = as_mask(ev[i].cond);
+    return res;
+  }
+
+  letter_sets::letter_sets(const bdd& aps)
+  {
+    read_vars("letter_sets", aps, max_aps, vars_, var_pos_);
+    unsigned nl = num_letters();
+    num_words_ = (nl + 63) / 64;
+    last_word_mask_ = nl >= 64 ? ~word_t(0) : (word_t(1) << nl) - 1;
+  }
+
+  void
+  letter_sets::compute(const bdd& label, set_t& res,
+                       std::unordered_map<bdd, set_t, bdd_hash>& memo)
+  {
+    if (label == bddtrue)
+      {
+        res.assign(num_words_, ~word_t(0));
+        res.back() &= last_word_mask_;
+        return;
+      }
+    if (label == bddfalse)
+      {
+        res.assign(num_words_, 0);
+        return;
+      }
+    auto it = memo.find(label);
+    if (it != memo.end())
+      {
+        res = it->second;
+        return;
+      }
+    int v = bdd_var(label);
+    if (SPOT_UNLIKELY((unsigned) v >= var_pos_.size() || var_pos_[v] < 0))
+      throw std::runtime_error("letter_sets: label uses a variable "
+                               "that is not in the alphabet");
+    set_t hi;
+    set_t lo;
+    compute(bdd_high(label), hi, memo);
+    compute(bdd_low(label), lo, memo);
+    // Shannon expansion, on all letters at once.  Variables
+    // associated to the 6 lowest bits of the letter numbers select
+    // bits inside each word; the other select whole words.
+    unsigned bit = vars_.size() - 1 - var_pos_[v];
+    res.resize(num_words_);
+    if (bit < 6)
+      {
+        word_t m = bit_masks[bit];
+        for (unsigned w = 0; w < num_words_; ++w)
+          res[w] = (m & hi[w]) | (~m & lo[w]);
+      }
+    else
+      {
+        unsigned wbit = bit - 6;
+        for (unsigned w = 0; w < num_words_; ++w)
+          res[w] = ((w >> wbit) & 1) ? hi[w] : lo[w];
+      }
+    res.back() &= last_word_mask_;
+    memo.emplace(label, res);
+  }
+
+  const letter_sets::set_t&
+  letter_sets::as_set(const bdd& label)
+  {
+    auto p = cache_.emplace(label, set_t());
+    if (p.second)
+      {
+        // Intermediate results are only kept for the duration of
+        // this conversion, as they can be large.
+        std::unordered_map<bdd, set_t, bdd_hash> memo;
+        compute(label, p.first->second, memo);
+      }
+    return p.first->second;
+  }
+
+  const bdd&
+  letter_sets::letter(unsigned i)
+  {
+    unsigned n = vars_.size();
+    if (letters_.empty())
+      letters_.resize(num_letters(), bddfalse);
+    bdd& res = letters_[i];
+    if (res == bddfalse)
+      {
+        // Build the cube bottom-up.
+        res = bddtrue;
+        for (unsigned pos = n; pos-- > 0;)
+          if ((i >> (n - 1 - pos)) & 1)
+            res &= bdd_ithvar(vars_[pos]);
+          else
+            res &= bdd_nithvar(vars_[pos]);
+      }
+    return res;
+  }
+
+  alphabet_partition::alphabet_partition(const const_twa_graph_ptr& aut)
+  {
+    auto& ev = aut->edge_vector();
+    unsigned ne = ev.size();
+    conds_.reserve(ne);
+    for (auto& e: ev)
+      conds_.push_back(e.cond);
+
+    // Refine the partition with each distinct label.
+    std::unordered_map<bdd, std::pair<unsigned, unsigned>, bdd_hash> labels;
+    classes_.push_back(bddtrue);
+    for (unsigned i = 1; i < ne; ++i)
+      {
+        const bdd& l = conds_[i];
+        if (!labels.emplace(l, std::make_pair(0U, 0U)).second
+            || l == bddtrue || l == bddfalse)
+          continue;
+        for (unsigned c = 0, nc = classes_.size(); c < nc; ++c)
+          {
+            bdd in = classes_[c] & l;
+            if (in == bddfalse || in == classes_[c])
+              continue;
+            bdd out = classes_[c] - l;
+            classes_[c] = in;
+            classes_.push_back(out);
+          }
+      }
+
+    // Record the classes of each label.
+    for (auto& p: labels)
+      {
+        p.second.first = members_.size();
+        if (p.first != bddfalse)
+          for (unsigned c = 0, nc = classes_.size(); c < nc; ++c)
+            if (bdd_implies(classes_[c], p.first))
+              members_.push_back(c);
+        p.second.second = members_.size();
+      }
+    edge_range_.resize(ne, std::make_pair(0U, 0U));
+    for (unsigned i = 1; i < ne; ++i)
+      edge_range_[i] = labels[conds_[i]];
+  }
+
+  bool
+  alphabet_partition::up_to_date(const const_twa_graph_ptr& aut) const
+  {
+    auto& ev = aut->edge_vector();
+    unsigned ne = ev.size();
+    if (ne != conds_.size())
+      return false;
+    for (unsigned i = 1; i < ne; ++i)
+      if (ev[i].cond != conds_[i])
+        return false;
+    return true;
+  }
+
+  const alphabet_partition*
+  alphabet_partition::cached(const const_twa_graph_ptr& aut)
+  {
+    auto* p =
+      aut->get_named_prop<alphabet_partition>("alphabet-partition");
+    if (p && p->up_to_date(aut))
+      return p;
+    return nullptr;
+  }
+
+  const alphabet_partition&
+  alphabet_partition::of(const const_twa_graph_ptr& aut)
+  {
+    if (auto* p = cached(aut))
+      return *p;
+    auto* p = new alphabet_partition(aut);
+    std::const_pointer_cast<twa_graph>(aut)
+      ->set_named_prop("alphabet-partition", p);
+    return *p;
+  }
+}
@@ -0,0 +1,302 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/twa/twagraph.hh>
+#include <spot/misc/bddlt.hh>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup twa_misc
+  /// \brief Represent edge labels as explicit sets of letters.
+  ///
+  /// For automata over few atomic propositions, an edge label can be
+  /// represented by the set of letters (i.e., assignments of all the
+  /// atomic propositions) that it accepts.  With at most 6 atomic
+  /// propositions, such a set fits into a 64-bit mask, and
+  /// conjunction, disjunction, emptiness or implication tests become
+  /// single machine instructions instead of BDD operations.
+  ///
+  /// The letters are numbered so that iterating over the bits of a
+  /// mask from the lowest to the highest visits the letters in the
+  /// same order as repeated calls to `bdd_satoneset(cond, aps,
+  /// bddfalse)`: the first atomic proposition (in the BDD variable
+  /// order) corresponds to the most significant bit of the letter
+  /// number.
+  ///
+  /// Conversions in both directions are cached.
+  class SPOT_API letter_masks final
+  {
+  public:
+    typedef uint64_t mask_t;
+
+    /// The maximal number of atomic propositions supported.
+    static constexpr unsigned max_aps = 6;
+
+    /// \brief Prepare masks for labels built on the variables of
+    /// \a aps.
+    ///
+    /// \a aps should be a conjunction of positive BDD variables, as
+    /// returned by twa::ap_vars().  An std::runtime_error is thrown
+    /// if it has more than max_aps variables.
+    explicit letter_masks(const bdd& aps);
+
+    /// \brief Whether masks can be used for the labels of \a aut.
+    static bool usable(const const_twa_ptr& aut)
+    {
+      return aut->ap().size() <= max_aps;
+    }
+
+    /// The number of letters of the alphabet.
+    unsigned num_letters() const
+    {
+      return 1U << vars_.size();
+    }
+
+    /// The mask representing all letters (i.e., bddtrue).
+    mask_t all() const
+    {
+      return all_;
+    }
+
+    /// \brief Convert a label into a set of letters.
+    ///
+    /// An std::runtime_error is thrown if \a label uses a BDD variable
+    /// that is not part of the alphabet.
+    mask_t as_mask(const bdd& label);
+
+    /// Convert a set of letters into a label.
+    bdd as_bdd(mask_t m);
+
+    /// The BDD for letter \a i.
+    bdd letter(unsigned i)
+    {
+      return as_bdd(mask_t(1) << i);
+    }
+
+    /// \brief Compute the masks of all the edges of \a aut.
+    ///
+    /// The result is indexed by edge number.
+    std::vector<mask_t> edge_masks(const const_twa_graph_ptr& aut);
+
+    /// \brief Call \a fun on each letter of \a m, in increasing
+    /// order.
+    template<class F>
+    static void for_each_letter(mask_t m, F fun)
+    {
+      while (m)
+        {
+#if __GNUC__
+          unsigned i = __builtin_ctzll(m);
+#else
+          unsigned i = 0;
+          while (!(m & (mask_t(1) << i)))
+            ++i;
+#endif
+          fun(i);
+          m &= m - 1;
+        }
+    }
+
+  private:
+    mask_t var_mask(unsigned pos) const;
+
+    std::vector<int> vars_;        // BDD variables, in BDD order
+    std::vector<int> var_pos_;     // BDD variable -> position, or -1
+    mask_t all_;
+    std::unordered_map<bdd, mask_t, bdd_hash> mask_cache_;
+    std::unordered_map<mask_t, bdd> bdd_cache_;
+  };
+
+  /// \ingroup twa_misc
+  /// \brief Represent edge labels as explicit sets of letters, for
+  /// alphabets of up to 16 atomic propositions.
+  ///
+  /// This generalizes letter_masks to larger alphabets: a set of
+  /// letters is stored as a vector of 64-bit words, and the
+  /// conversion from a BDD to a set of letters evaluates the label on
+  /// all letters at once, using word-level operations for each node
+  /// of the BDD.  Enumerating the letters of a label is then a scan
+  /// of its bits, instead of a sequence of `bdd_satoneset()` and BDD
+  /// differences.
+  ///
+  /// Letters are numbered as in letter_masks, i.e., in the order in
+  /// which `bdd_satoneset(cond, aps, bddfalse)` would produce them.
+  class SPOT_API letter_sets final
+  {
+  public:
+    typedef letter_masks::mask_t word_t;
+    typedef std::vector<word_t> set_t;
+
+    /// The maximal number of atomic propositions supported.
+    static constexpr unsigned max_aps = 16;
+
+    /// \brief Prepare sets for labels built on the variables of
+    /// \a aps.
+    ///
+    /// \a aps should be a conjunction of positive BDD variables, as
+    /// returned by twa::ap_vars().  An std::runtime_error is thrown
+    /// if it has more than max_aps variables.
+    explicit letter_sets(const bdd& aps);
+
+    /// \brief Whether letter sets can be used for the labels of \a aut.
+    static bool usable(const const_twa_ptr& aut)
+    {
+      return aut->ap().size() <= max_aps;
+    }
+
+    /// The number of letters of the alphabet.
+    unsigned num_letters() const
+    {
+      return 1U << vars_.size();
+    }
+
+    /// The number of words used to represent a set of letters.
+    unsigned num_words() const
+    {
+      return num_words_;
+    }
+
+    /// \brief Convert a label into a set of letters.
+    ///
+    /// The result is cached, and the returned reference remains valid
+    /// as long as this object.  An std::runtime_error is thrown if
+    /// \a label uses a BDD variable that is not part of the alphabet.
+    const set_t& as_set(const bdd& label);
+
+    /// The BDD for letter \a i.
+    const bdd& letter(unsigned i);
+
+    /// \brief Call \a fun on each letter of \a s, in increasing
+    /// order.
+    template<class F>
+    static void for_each_letter(const set_t& s, F fun)
+    {
+      unsigned n = s.size();
+      for (unsigned w = 0; w < n; ++w)
+        letter_masks::for_each_letter(s[w], [&](unsigned i)
+                                      {
+                                        fun(64 * w + i);
+                                      });
+    }
+
+  private:
+    void compute(const bdd& label, set_t& res,
+                 std::unordered_map<bdd, set_t, bdd_hash>& memo);
+
+    std::vector<int> vars_;        // BDD variables, in BDD order
+    std::vector<int> var_pos_;     // BDD variable -> position, or -1
+    unsigned num_words_;
+    word_t last_word_mask_;
+    std::unordered_map<bdd, set_t, bdd_hash> cache_;
+    std::vector<bdd> letters_;
+  };
+
+  /// \ingroup twa_misc
+  /// \brief Partition of the alphabet induced by the labels of an
+  /// automaton.
+  ///
+  /// The classes of this partition are the coarsest set of disjoint,
+  /// non-false BDDs such that the label of each edge is a disjunction
+  /// of classes.  Algorithms that only need to know which letters
+  /// two edges have in common can then work on class numbers instead
+  /// of performing BDD operations.
+  ///
+  /// The partition can be cached in the automaton as the named
+  /// property "alphabet-partition" by calling of().  Since the
+  /// automaton may be modified afterwards, cached() checks that the
+  /// labels have not changed before returning a cached partition.
+  class SPOT_API alphabet_partition final
+  {
+  public:
+    /// Range of class numbers, in increasing order.
+    class class_range final
+    {
+    public:
+      class_range(const unsigned* b, const unsigned* e) noexcept
+        : b_(b), e_(e)
+      {
+      }
+
+      const unsigned* begin() const noexcept
+      {
+        return b_;
+      }
+
+      const unsigned* end() const noexcept
+      {
+        return e_;
+      }
+
+      unsigned size() const noexcept
+      {
+        return e_ - b_;
+      }
+
+    private:
+      const unsigned* b_;
+      const unsigned* e_;
+    };
+
+    /// Compute the partition induced by the labels of \a aut.
+    explicit alphabet_partition(const const_twa_graph_ptr& aut);
+
+    /// The number of classes.
+    unsigned num_classes() const
+    {
+      return classes_.size();
+    }
+
+    /// The BDD of class \a c.
+    const bdd& class_bdd(unsigned c) const
+    {
+      return classes_[c];
+    }
+
+    /// The classes whose disjunction is the label of edge \a e.
+    class_range classes_of(unsigned e) const
+    {
+      auto& p = edge_range_[e];
+      const unsigned* b = members_.data();
+      return {b + p.first, b + p.second};
+    }
+
+    /// \brief Whether this partition still matches the labels of
+    /// \a aut.
+    bool up_to_date(const const_twa_graph_ptr& aut) const;
+
+    /// \brief Return the partition cached in \a aut, computing and
+    /// caching it first if needed.
+    static const alphabet_partition& of(const const_twa_graph_ptr& aut);
+
+    /// \brief Return the partition cached in \a aut, or nullptr if
+    /// there is none, or if it is out of date.
+    static const alphabet_partition* cached(const const_twa_graph_ptr& aut);
+
+  private:
+    std::vector<bdd> classes_;
+    std::vector<bdd> conds_;      // label of each edge
+    std::vector<std::pair<unsigned, unsigned>> edge_range_;
+    std::vector<unsigned> members_;
+  };
+}
@@ -36,6 +36,20 @@
 
 namespace spot
 {
+  unsigned
+  twa_succ_iterator::fill(std::vector<twa_succ>& buf)
+  {
+    unsigned n = 0;
+    if (first())
+      do
+        {
+          buf.push_back({dst(), cond(), acc()});
+          ++n;
+        }
+      while (next());
+    return n;
+  }
+
   twa::twa(const bdd_dict_ptr& d)
     : iter_cache_(nullptr),
       dict_(d)
@@ -346,6 +346,18 @@ namespace spot
                              state_shared_ptr_hash,
                              state_shared_ptr_equal> shared_state_set;
 
+  /// \ingroup twa_essentials
+  /// \brief A successor, as output by twa_succ_iterator::fill().
+  struct SPOT_API twa_succ
+  {
+    /// The destination state, owned by whoever called fill().
+    const state* dst;
+    /// The condition of the edge.
+    bdd cond;
+    /// The acceptance mark of the edge.
+    acc_cond::mark_t acc;
+  };
+
   /// \ingroup twa_essentials
   /// \brief Iterate over the successors of a state.
   ///
@@ -394,6 +406,9 @@ namespace spot
   ///
   /// This loop uses the return value of first() and next() to save
   /// n+1 calls to done().
+  ///
+  /// Algorithms that do not need to process the successors lazily
+  /// can also retrieve all of them with a single call to fill().
   class SPOT_API twa_succ_iterator
   {
   public:
@@ -474,6 +489,19 @@ namespace spot
     virtual acc_cond::mark_t acc() const = 0;
 
     ///@}
+
+    /// \brief Append all successors to \a buf.
+    ///
+    /// This is equivalent to iterating over all successors with
+    /// first() and next(), and appending one twa_succ made of dst(),
+    /// cond(), and acc() to \a buf for each of them, but iterators
+    /// that can do so override this method to save these virtual
+    /// calls.  The position of the iterator is unspecified after this
+    /// call, so first() must be called before using it again.  The
+    /// caller is responsible for destroying the appended states.
+    ///
+    /// \return the number of appended successors.
+    virtual unsigned fill(std::vector<twa_succ>& buf);
   };
 
   namespace internal
@@ -188,6 +188,18 @@ namespace spot
       return g_->edge_data(p_).acc;
     }
 
+    virtual unsigned fill(std::vector<twa_succ>& buf) override
+    {
+      unsigned n = 0;
+      for (p_ = t_; p_; p_ = g_->edge_storage(p_).next_succ)
+        {
+          auto& e = g_->edge_storage(p_);
+          buf.push_back({&g_->state_data(e.dst), e.cond, e.acc});
+          ++n;
+        }
+      return n;
+    }
+
     edge pos() const
     {
       return p_;
@@ -0,0 +1,252 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/twa/twahandle.hh>
+#include <spot/twa/twagraph.hh>
+#include <spot/kripke/kripke.hh>
+#include <spot/misc/hash.hh>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace spot
+{
+  handle_twa::~handle_twa()
+  {
+  }
+
+  namespace
+  {
+    // A twa_graph, whose state numbers are used as handles.
+    class twa_graph_handles final: public handle_twa
+    {
+    public:
+      twa_graph_handles(const const_twa_graph_ptr& aut)
+        : handle_twa(aut->get_dict(), aut->acc()), aut_(aut)
+      {
+        if (!aut->is_existential())
+          throw std::runtime_error
+            ("make_handle_twa() does not support alternation");
+      }
+
+      state_handle get_init_state() const override
+      {
+        return aut_->get_init_state_number();
+      }
+
+      unsigned succ(state_handle s,
+                    std::vector<handle_succ>& out) const override
+      {
+        unsigned n = 0;
+        for (auto& e: aut_->out(s))
+          {
+            out.push_back({e.dst, e.cond, e.acc});
+            ++n;
+          }
+        return n;
+      }
+
+      size_t num_states() const override
+      {
+        return aut_->num_states();
+      }
+
+      std::string format_state(state_handle s) const override
+      {
+        return aut_->format_state(s);
+      }
+
+    private:
+      const_twa_graph_ptr aut_;
+    };
+
+    // Any twa, whose states are stored as they are discovered.
+    class twa_handles final: public handle_twa
+    {
+    public:
+      twa_handles(const const_twa_ptr& aut)
+        : handle_twa(aut->get_dict(), aut->acc()), aut_(aut)
+      {
+        kripke_ = !!dynamic_cast<const kripke*>(aut.get());
+      }
+
+      ~twa_handles()
+      {
+        for (auto s: states_)
+          s->destroy();
+      }
+
+      state_handle get_init_state() const override
+      {
+        return intern(aut_->get_init_state());
+      }
+
+      unsigned succ(state_handle s,
+                    std::vector<handle_succ>& out) const override
+      {
+        buf_.clear();
+        twa_succ_iterator* it = aut_->succ_iter(states_[s]);
+        unsigned n = it->fill(buf_);
+        aut_->release_iter(it);
+        for (auto& e: buf_)
+          out.push_back({intern(e.dst), e.cond, e.acc});
+        return n;
+      }
+
+      size_t num_states() const override
+      {
+        return states_.size();
+      }
+
+      std::string format_state(state_handle s) const override
+      {
+        return aut_->format_state(states_[s]);
+      }
+
+    private:
+      // Return the handle of S, which is destroyed if it was already
+      // known.
+      state_handle intern(const state* s) const
+      {
+        auto p = index_.emplace(s, states_.size());
+        if (p.second)
+          states_.push_back(s);
+        else
+          s->destroy();
+        return p.first->second;
+      }
+
+      const_twa_ptr aut_;
+      mutable std::vector<const state*> states_;
+      mutable state_map<state_handle> index_;
+      mutable std::vector<twa_succ> buf_;
+    };
+
+    struct handle_pair_hash
+    {
+      size_t
+      operator()(const std::pair<state_handle, state_handle>& p)
+        const noexcept
+      {
+        return wang32_hash(p.first ^ wang32_hash(p.second));
+      }
+    };
+
+    class product_handles final: public handle_twa
+    {
+    public:
+      product_handles(const const_handle_twa_ptr& left,
+                      const const_handle_twa_ptr& right)
+        : handle_twa(left->get_dict(), left->acc()),
+          left_(left), right_(right)
+      {
+        if (left->get_dict() != right->get_dict())
+          throw std::runtime_error("handle_product: left and right automata "
+                                   "should share their bdd_dict");
+        // Like twa_product, keep a Kripke structure on the left.  As
+        // it has no acceptance set, the marks of the successors and
+        // the acceptance condition below, built from the operands in
+        // their original order, agree.
+        if (right->is_kripke() && !left->is_kripke())
+          std::swap(left_, right_);
+        left_sets_ = left_->acc().num_sets();
+        unsigned left_num = left->acc().num_sets();
+        auto right_acc = right->acc().get_acceptance() << left_num;
+        right_acc &= left->acc().get_acceptance();
+        acc_ = acc_cond(left_num + right->acc().num_sets(), right_acc);
+      }
+
+      state_handle get_init_state() const override
+      {
+        return intern(left_->get_init_state(), right_->get_init_state());
+      }
+
+      // Same order as twa_succ_iterator_product.
+      unsigned succ(state_handle s,
+                    std::vector<handle_succ>& out) const override
+      {
+        auto p = pairs_[s];
+        lbuf_.clear();
+        rbuf_.clear();
+        if (!left_->succ(p.first, lbuf_) || !right_->succ(p.second, rbuf_))
+          return 0;
+        unsigned n = 0;
+        for (auto& r: rbuf_)
+          {
+            acc_cond::mark_t racc = r.acc << left_sets_;
+            for (auto& l: lbuf_)
+              {
+                bdd cond = l.cond & r.cond;
+                if (cond == bddfalse)
+                  continue;
+                out.push_back({intern(l.dst, r.dst), cond, l.acc | racc});
+                ++n;
+              }
+          }
+        return n;
+      }
+
+      size_t num_states() const override
+      {
+        return pairs_.size();
+      }
+
+      std::string format_state(state_handle s) const override
+      {
+        auto p = pairs_[s];
+        return (left_->format_state(p.first)
+                + " * "
+                + right_->format_state(p.second));
+      }
+
+    private:
+      state_handle intern(state_handle l, state_handle r) const
+      {
+        auto p = index_.emplace(std::make_pair(l, r), pairs_.size());
+        if (p.second)
+          pairs_.emplace_back(l, r);
+        return p.first->second;
+      }
+
+      const_handle_twa_ptr left_;
+      const_handle_twa_ptr right_;
+      unsigned left_sets_;
+      mutable std::vector<std::pair<state_handle, state_handle>> pairs_;
+      mutable std::unordered_map<std::pair<state_handle, state_handle>,
+                                 state_handle, handle_pair_hash> index_;
+      mutable std::vector<handle_succ> lbuf_;
+      mutable std::vector<handle_succ> rbuf_;
+    };
+  }
+
+  handle_twa_ptr
+  make_handle_twa(const const_twa_ptr& aut)
+  {
+    if (auto g = std::dynamic_pointer_cast<const twa_graph>(aut))
+      return std::make_shared<twa_graph_handles>(g);
+    return std::make_shared<twa_handles>(aut);
+  }
+
+  handle_twa_ptr
+  handle_product(const const_handle_twa_ptr& left,
+                 const const_handle_twa_ptr& right)
+  {
+    return std::make_shared<product_handles>(left, right);
+  }
+}
@@ -0,0 +1,153 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/twa/fwd.hh>
+#include <spot/twa/acc.hh>
+#include <spot/twa/bdddict.hh>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup twa_essentials
+  /// \brief The handle of a state of a handle_twa.
+  typedef uint64_t state_handle;
+
+  /// \ingroup twa_essentials
+  /// \brief A successor, as output by handle_twa::succ().
+  struct SPOT_API handle_succ
+  {
+    /// The destination state.
+    state_handle dst;
+    /// The condition of the edge.
+    bdd cond;
+    /// The acceptance mark of the edge.
+    acc_cond::mark_t acc;
+  };
+
+  class handle_twa;
+  typedef std::shared_ptr<handle_twa> handle_twa_ptr;
+  typedef std::shared_ptr<const handle_twa> const_handle_twa_ptr;
+
+  /// \ingroup twa_essentials
+  /// \brief An on-the-fly automaton whose states are integers.
+  ///
+  /// The on-the-fly interface of twa represents states by objects
+  /// that the algorithms have to clone(), compare(), hash(), and
+  /// destroy().  A handle_twa instead keeps all the states it has
+  /// produced in a store of its own, and gives them to the
+  /// algorithms as 64-bit handles.  Two handles are equal iff they
+  /// denote the same state, and all handles are smaller than
+  /// num_states(), so algorithms can attach data to states using
+  /// vectors indexed by handles.  Automata that store their states
+  /// number them consecutively from 0 in the order in which they are
+  /// discovered; make_handle_twa() uses the state numbers of a
+  /// twa_graph instead.
+  ///
+  /// The store only grows: the memory used by the states is released
+  /// when the automaton is destroyed.  The successors of a state are
+  /// computed again each time succ() is called.
+  class SPOT_API handle_twa
+  {
+  public:
+    handle_twa(const bdd_dict_ptr& dict, const acc_cond& acc)
+      : dict_(dict), acc_(acc)
+    {
+    }
+
+    virtual ~handle_twa();
+
+    /// The handle of the initial state.
+    virtual state_handle get_init_state() const = 0;
+
+    /// \brief Append the successors of \a s to \a out.
+    ///
+    /// \return the number of appended successors.
+    virtual unsigned succ(state_handle s,
+                          std::vector<handle_succ>& out) const = 0;
+
+    /// \brief An upper bound on the handles returned so far.
+    ///
+    /// All handles returned so far are smaller than this number.  For
+    /// automata that store their states, this is the number of states
+    /// discovered so far.  For a twa_graph presented by
+    /// make_handle_twa(), this is the number of states of the graph,
+    /// including those that are not reachable.
+    virtual size_t num_states() const = 0;
+
+    /// Format the state \a s for output.
+    virtual std::string format_state(state_handle s) const = 0;
+
+    /// The BDD dictionary used by the conditions.
+    const bdd_dict_ptr& get_dict() const
+    {
+      return dict_;
+    }
+
+    /// The acceptance condition of the automaton.
+    const acc_cond& acc() const
+    {
+      return acc_;
+    }
+
+    /// \brief Whether this presents a Kripke structure.
+    ///
+    /// All the successors of a state of a Kripke structure have the
+    /// same condition, and no acceptance mark.
+    bool is_kripke() const
+    {
+      return kripke_;
+    }
+
+  protected:
+    bdd_dict_ptr dict_;
+    acc_cond acc_;
+    bool kripke_ = false;
+  };
+
+  /// \ingroup twa_misc
+  /// \brief Present a twa through the handle_twa interface.
+  ///
+  /// A twa_graph is used directly: handles are its state numbers, and
+  /// no store is needed.  Other automata are explored through their
+  /// on-the-fly interface, and their states are stored as they are
+  /// discovered.  This throws an std::runtime_error if \a aut is an
+  /// alternating twa_graph.
+  SPOT_API handle_twa_ptr
+  make_handle_twa(const const_twa_ptr& aut);
+
+  /// \ingroup twa_misc
+  /// \brief On-the-fly product of two handle_twa.
+  ///
+  /// The pairs of handles of the product are stored as they are
+  /// discovered.  As in twa_product, if \a right is a Kripke structure
+  /// and \a left is not, the two operands are swapped, so that the
+  /// Kripke structure is on the left of the pairs.  Successors are
+  /// then enumerated in the same order as with twa_product, and the
+  /// acceptance sets of \a right are shifted after those of \a left.
+  /// Both operands should share their bdd_dict, otherwise an
+  /// std::runtime_error is thrown.
+  SPOT_API handle_twa_ptr
+  handle_product(const const_handle_twa_ptr& left,
+                 const const_handle_twa_ptr& right);
+}
@@ -26,6 +26,8 @@
 #include <cassert>
 #include <spot/misc/hashfunc.hh>
 #include <spot/kripke/kripke.hh>
+#include <spot/kripke/kripkegraph.hh>
+#include <spot/twa/twagraph.hh>
 
 namespace spot
 {
@@ -73,6 +75,44 @@ namespace spot
     return const_cast<state_product*>(this);
   }
 
+  ////////////////////////////////////////////////////////////
+  // state_product_explicit
+
+  void
+  state_product_explicit::destroy() const
+  {
+    if (--count_)
+      return;
+    fixed_size_pool* p = pool_;
+    this->~state_product_explicit();
+    p->deallocate(const_cast<state_product_explicit*>(this));
+  }
+
+  int
+  state_product_explicit::compare(const state* other) const
+  {
+    const state_product_explicit* o =
+      down_cast<const state_product_explicit*>(other);
+    if (left_ != o->left_)
+      return left_ < o->left_ ? -1 : 1;
+    if (right_ != o->right_)
+      return right_ < o->right_ ? -1 : 1;
+    return 0;
+  }
+
+  size_t
+  state_product_explicit::hash() const
+  {
+    return wang32_hash(left_ ^ wang32_hash(right_));
+  }
+
+  state_product_explicit*
+  state_product_explicit::clone() const
+  {
+    ++count_;
+    return const_cast<state_product_explicit*>(this);
+  }
+
   ////////////////////////////////////////////////////////////
   // twa_succ_iterator_product
 
@@ -137,11 +177,47 @@ namespace spot
                                                     pool_);
       }
 
+      // Fetch the successors of both operands at once, and combine
+      // them in the order used by next().  The acceptance marks are
+      // computed as in twa_succ_iterator_product::acc(), which is
+      // also correct for a Kripke structure, as it has no
+      // acceptance set.
+      unsigned fill(std::vector<twa_succ>& buf) override
+      {
+        if (!right_)
+          return 0;
+        lbuf_.clear();
+        rbuf_.clear();
+        left_->fill(lbuf_);
+        right_->fill(rbuf_);
+        unsigned left_sets = prod_->left_acc().num_sets();
+        unsigned n = 0;
+        for (auto& r: rbuf_)
+          for (auto& l: lbuf_)
+            {
+              bdd cond = l.cond & r.cond;
+              if (cond == bddfalse)
+                continue;
+              auto* s = new(pool_->allocate())
+                state_product(l.dst->clone(), r.dst->clone(), pool_);
+              buf.push_back({s, cond, l.acc | (r.acc << left_sets)});
+              ++n;
+            }
+        for (auto& l: lbuf_)
+          l.dst->destroy();
+        for (auto& r: rbuf_)
+          r.dst->destroy();
+        return n;
+      }
+
     protected:
       twa_succ_iterator* left_;
       twa_succ_iterator* right_;
       const twa_product* prod_;
       fixed_size_pool* pool_;
+      // Successors of the operands, used by fill().
+      std::vector<twa_succ> lbuf_;
+      std::vector<twa_succ> rbuf_;
       friend class spot::twa_product;
     };
 
@@ -274,6 +350,222 @@ namespace spot
       bdd current_cond_;
     };
 
+    // Non-virtual access to the edges of the explicit operands of
+    // twa_product_explicit.  Edge 0 does not exist, so it is used to
+    // mark the end of a list of successors.
+    struct twa_graph_edges
+    {
+      const twa_graph::graph_t* g;
+
+      unsigned first(unsigned s) const
+      {
+        return g->state_storage(s).succ;
+      }
+
+      unsigned next(unsigned e) const
+      {
+        return g->edge_storage(e).next_succ;
+      }
+
+      unsigned dst(unsigned e) const
+      {
+        return g->edge_storage(e).dst;
+      }
+
+      bdd cond(unsigned, unsigned e) const
+      {
+        return g->edge_storage(e).cond;
+      }
+
+      acc_cond::mark_t acc(unsigned e) const
+      {
+        return g->edge_storage(e).acc;
+      }
+    };
+
+    struct kripke_graph_edges
+    {
+      const kripke_graph* k;
+
+      unsigned first(unsigned s) const
+      {
+        return down_cast<const kripke_graph::state_storage_t*>
+          (k->state_from_number(s))->succ;
+      }
+
+      unsigned next(unsigned e) const
+      {
+        return k->edge_storage(e).next_succ;
+      }
+
+      unsigned dst(unsigned e) const
+      {
+        return k->edge_storage(e).dst;
+      }
+
+      // The label of a Kripke structure is on its states.
+      bdd cond(unsigned s, unsigned) const
+      {
+        return k->state_from_number(s)->cond();
+      }
+
+      acc_cond::mark_t acc(unsigned) const
+      {
+        return {};
+      }
+    };
+
+    class twa_succ_iterator_product_explicit_base: public twa_succ_iterator
+    {
+    public:
+      twa_succ_iterator_product_explicit_base(unsigned left, unsigned right)
+        : ls_(left), rs_(right)
+      {
+      }
+
+      void recycle(unsigned left, unsigned right)
+      {
+        ls_ = left;
+        rs_ = right;
+      }
+
+    protected:
+      unsigned ls_;             // source state in the left operand
+      unsigned rs_;             // source state in the right operand
+      unsigned le_ = 0;         // current edge in the left operand
+      unsigned re_ = 0;         // current edge in the right operand
+    };
+
+    /// \brief Iterate over the successors of a product of explicit
+    /// automata, in the same order as twa_succ_iterator_product.
+    template<class L, class R>
+    class twa_succ_iterator_product_explicit final:
+      public twa_succ_iterator_product_explicit_base
+    {
+    public:
+      twa_succ_iterator_product_explicit(L l, R r,
+                                         unsigned left, unsigned right,
+                                         unsigned left_sets,
+                                         fixed_size_pool* pool)
+        : twa_succ_iterator_product_explicit_base(left, right),
+          l_(l), r_(r), left_sets_(left_sets), pool_(pool)
+      {
+      }
+
+      bool first() override
+      {
+        le_ = l_.first(ls_);
+        re_ = r_.first(rs_);
+        if (!le_ || !re_)
+          {
+            re_ = 0;
+            return false;
+          }
+        return next_non_false_();
+      }
+
+      bool next() override
+      {
+        if (step_())
+          return next_non_false_();
+        return false;
+      }
+
+      bool done() const override
+      {
+        return !re_;
+      }
+
+      const state_product_explicit* dst() const override
+      {
+        return new(pool_->allocate())
+          state_product_explicit(l_.dst(le_), r_.dst(re_), pool_);
+      }
+
+      bdd cond() const override
+      {
+        return current_cond_;
+      }
+
+      acc_cond::mark_t acc() const override
+      {
+        return l_.acc(le_) | (r_.acc(re_) << left_sets_);
+      }
+
+      unsigned fill(std::vector<twa_succ>& buf) override
+      {
+        unsigned n = 0;
+        unsigned lfirst = l_.first(ls_);
+        re_ = 0;
+        if (!lfirst)
+          return 0;
+        for (unsigned re = r_.first(rs_); re; re = r_.next(re))
+          {
+            bdd rcond = r_.cond(rs_, re);
+            acc_cond::mark_t racc = r_.acc(re) << left_sets_;
+            for (unsigned le = lfirst; le; le = l_.next(le))
+              {
+                bdd cond = l_.cond(ls_, le) & rcond;
+                if (cond == bddfalse)
+                  continue;
+                auto* s = new(pool_->allocate())
+                  state_product_explicit(l_.dst(le), r_.dst(re), pool_);
+                buf.push_back({s, cond, l_.acc(le) | racc});
+                ++n;
+              }
+          }
+        return n;
+      }
+
+    private:
+      bool step_()
+      {
+        le_ = l_.next(le_);
+        if (le_)
+          return true;
+        le_ = l_.first(ls_);
+        re_ = r_.next(re_);
+        return re_;
+      }
+
+      bool next_non_false_()
+      {
+        do
+          {
+            bdd current_cond = l_.cond(ls_, le_) & r_.cond(rs_, re_);
+            if (current_cond != bddfalse)
+              {
+                current_cond_ = current_cond;
+                return true;
+              }
+          }
+        while (step_());
+        return false;
+      }
+
+      L l_;
+      R r_;
+      unsigned left_sets_;
+      fixed_size_pool* pool_;
+      bdd current_cond_;
+    };
+
+    template<class L, class R>
+    twa_succ_iterator*
+    new_explicit_iterator(L l, R r, unsigned left, unsigned right,
+                          unsigned left_sets, fixed_size_pool* pool)
+    {
+      return new twa_succ_iterator_product_explicit<L, R>(l, r, left, right,
+                                                          left_sets, pool);
+    }
+
+    static bool
+    is_explicit_operand(const const_twa_ptr& a)
+    {
+      if (auto g = dynamic_cast<const twa_graph*>(a.get()))
+        return g->is_existential();
+      return dynamic_cast<const kripke_graph*>(a.get());
+    }
   } // anonymous
 
   ////////////////////////////////////////////////////////////
@@ -386,6 +678,122 @@ namespace spot
     return right_->project_state(s2->right(), t);
   }
 
+  //////////////////////////////////////////////////////////////////////
+  // twa_product_explicit
+
+  twa_product_explicit::twa_product_explicit(const const_twa_ptr& left,
+                                             const const_twa_ptr& right)
+    : twa_product(left, right),
+      explicit_pool_(sizeof(state_product_explicit))
+  {
+    if (!supports(left, right))
+      throw std::runtime_error("twa_product_explicit: operands should be "
+                               "kripke_graph or existential twa_graph");
+    // The operands may have been swapped by twa_product.
+    left_graph_ = dynamic_cast<const twa_graph*>(left_.get());
+    left_kripke_graph_ = dynamic_cast<const kripke_graph*>(left_.get());
+    right_graph_ = dynamic_cast<const twa_graph*>(right_.get());
+    right_kripke_graph_ = dynamic_cast<const kripke_graph*>(right_.get());
+  }
+
+  bool
+  twa_product_explicit::supports(const const_twa_ptr& left,
+                                 const const_twa_ptr& right)
+  {
+    return is_explicit_operand(left) && is_explicit_operand(right);
+  }
+
+  const state*
+  twa_product_explicit::left_state(unsigned n) const
+  {
+    if (left_graph_)
+      return left_graph_->state_from_number(n);
+    return left_kripke_graph_->state_from_number(n);
+  }
+
+  const state*
+  twa_product_explicit::right_state(unsigned n) const
+  {
+    if (right_graph_)
+      return right_graph_->state_from_number(n);
+    return right_kripke_graph_->state_from_number(n);
+  }
+
+  const state*
+  twa_product_explicit::get_init_state() const
+  {
+    unsigned l = left_graph_ ? left_graph_->get_init_state_number()
+      : left_kripke_graph_->get_init_state_number();
+    unsigned r = right_graph_ ? right_graph_->get_init_state_number()
+      : right_kripke_graph_->get_init_state_number();
+    fixed_size_pool* p = const_cast<fixed_size_pool*>(&explicit_pool_);
+    return new(p->allocate()) state_product_explicit(l, r, p);
+  }
+
+  twa_succ_iterator*
+  twa_product_explicit::succ_iter(const state* state) const
+  {
+    const state_product_explicit* s =
+      down_cast<const state_product_explicit*>(state);
+    unsigned l = s->left();
+    unsigned r = s->right();
+
+    if (iter_cache_)
+      {
+        auto it =
+          down_cast<twa_succ_iterator_product_explicit_base*>(iter_cache_);
+        it->recycle(l, r);
+        iter_cache_ = nullptr;
+        return it;
+      }
+
+    fixed_size_pool* p = const_cast<fixed_size_pool*>(&explicit_pool_);
+    unsigned ls = left_->num_sets();
+    if (left_graph_)
+      {
+        twa_graph_edges le{&left_graph_->get_graph()};
+        if (right_graph_)
+          return new_explicit_iterator(le,
+                                       twa_graph_edges
+                                       {&right_graph_->get_graph()},
+                                       l, r, ls, p);
+        return new_explicit_iterator(le,
+                                     kripke_graph_edges{right_kripke_graph_},
+                                     l, r, ls, p);
+      }
+    kripke_graph_edges le{left_kripke_graph_};
+    if (right_graph_)
+      return new_explicit_iterator(le,
+                                   twa_graph_edges{&right_graph_->get_graph()},
+                                   l, r, ls, p);
+    return new_explicit_iterator(le, kripke_graph_edges{right_kripke_graph_},
+                                 l, r, ls, p);
+  }
+
+  std::string
+  twa_product_explicit::format_state(const state* state) const
+  {
+    const state_product_explicit* s =
+      down_cast<const state_product_explicit*>(state);
+    return (left_->format_state(left_state(s->left()))
+            + " * "
+            + right_->format_state(right_state(s->right())));
+  }
+
+  state*
+  twa_product_explicit::project_state(const state* s,
+                                      const const_twa_ptr& t) const
+  {
+    const state_product_explicit* s2 =
+      down_cast<const state_product_explicit*>(s);
+    if (t.get() == this)
+      return s2->clone();
+    state* res = left_->project_state(left_state(s2->left()), t);
+    if (res)
+      return res;
+    return right_->project_state(right_state(s2->right()), t);
+  }
+
   //////////////////////////////////////////////////////////////////////
   // twa_product_init
 
@@ -77,6 +77,55 @@ namespace spot
     state_product(const state_product& o) = delete;
   };
 
+  /// \ingroup twa_on_the_fly_algorithms
+  /// \brief A state for spot::twa_product_explicit.
+  ///
+  /// This state stores the numbers of the states of the two operands
+  /// instead of pointers to them, so that it can be hashed and
+  /// compared without calling methods of the operands.
+  class SPOT_API state_product_explicit final: public state
+  {
+  public:
+    /// \brief Constructor
+    /// \param left The number of the state of the left automaton.
+    /// \param right The number of the state of the right automaton.
+    /// \param pool The pool from which the state was allocated.
+    state_product_explicit(unsigned left, unsigned right,
+                           fixed_size_pool* pool)
+      : left_(left), right_(right), count_(1), pool_(pool)
+    {
+    }
+
+    virtual void destroy() const override;
+
+    unsigned
+    left() const
+    {
+      return left_;
+    }
+
+    unsigned
+    right() const
+    {
+      return right_;
+    }
+
+    virtual int compare(const state* other) const override;
+    virtual size_t hash() const override;
+    virtual state_product_explicit* clone() const override;
+
+  private:
+    unsigned left_;             ///< State number in the left automaton.
+    unsigned right_;            ///< State number in the right automaton.
+    mutable unsigned count_;
+    fixed_size_pool* pool_;
+
+    virtual ~state_product_explicit()
+    {
+    }
+    state_product_explicit(const state_product_explicit& o) = delete;
+  };
+
 
   /// \brief A lazy product.  (States are computed on the fly.)
   class SPOT_API twa_product: public twa
@@ -127,10 +176,61 @@ namespace spot
     const state* right_init_;
   };
 
+  class kripke_graph;
+
+  /// \brief A lazy product of two explicit automata.
+  ///
+  /// Each operand should be a spot::kripke_graph, or a
+  /// spot::twa_graph without universal edges.  The states of this
+  /// product are instances of spot::state_product_explicit, and the
+  /// successors are computed by walking the edges of the two graphs
+  /// directly.  The successors are listed in the same order as in
+  /// spot::twa_product.
+  class SPOT_API twa_product_explicit final: public twa_product
+  {
+  public:
+    /// \brief Constructor.
+    ///
+    /// An std::runtime_error is thrown if supports() does not hold.
+    twa_product_explicit(const const_twa_ptr& left,
+                         const const_twa_ptr& right);
+
+    /// \brief Whether the product of \a left and \a right can be
+    /// represented by this class.
+    static bool supports(const const_twa_ptr& left,
+                         const const_twa_ptr& right);
+
+    virtual const state* get_init_state() const override;
+
+    virtual twa_succ_iterator*
+    succ_iter(const state* state) const override;
+
+    virtual std::string format_state(const state* state) const override;
+
+    virtual state* project_state(const state* s, const const_twa_ptr& t)
+      const override;
+
+  private:
+    const state* left_state(unsigned n) const;
+    const state* right_state(unsigned n) const;
+
+    const twa_graph* left_graph_;
+    const kripke_graph* left_kripke_graph_;
+    const twa_graph* right_graph_;
+    const kripke_graph* right_kripke_graph_;
+    fixed_size_pool explicit_pool_;
+  };
+
   /// \brief on-the-fly TGBA product
+  ///
+  /// When both operands are explicit (see
+  /// twa_product_explicit::supports()), the product is a
+  /// spot::twa_product_explicit.
   inline twa_product_ptr otf_product(const const_twa_ptr& left,
                                       const const_twa_ptr& right)
   {
+    if (twa_product_explicit::supports(left, right))
+      return SPOT_make_shared_enabled__(twa_product_explicit, left, right);
     return SPOT_make_shared_enabled__(twa_product, left, right);
   }
 
@@ -25,6 +25,7 @@
 #include <spot/twaalgos/bfssteps.hh>
 #include <spot/twaalgos/emptiness.hh>
 #include <spot/twaalgos/emptiness_stats.hh>
+#include <spot/twaalgos/lossyset.hh>
 
 #include <stack>
 
@@ -113,6 +114,13 @@ namespace spot
         return std::make_pair(*p.first, p.second);
       }
 
+      static
+      void
+      h_erase(state_map<int>& h, state_t s)
+      {
+        h.erase(s);
+      }
+
       static
       std::pair<state_t, int>
       h_find(const state_map<int>& h, state_t s)
@@ -205,6 +213,13 @@ namespace spot
         }
       }
 
+      static
+      void
+      h_erase(state_map<int>& h, state_t s)
+      {
+        h[s] = 0;
+      }
+
       static
       std::pair<state_t, int>
       h_find(const state_map<int>& h, state_t s)
@@ -562,12 +577,16 @@ namespace spot
       using pair_state_iter = std::pair<state_t, iterator_t>;
 
       couvreur99_new_status_ptr<is_explicit> ecs_;
+      // Lossy set of visited states, if requested by the options.  The
+      // states of dead SCCs are then removed from h.
+      std::unique_ptr<lossy_state_set> lossy_;
 
     public:
       couvreur99_new(const automaton_ptr<is_explicit>& a,
                      option_map o = option_map())
         : emptiness_check(a, o)
         , ecs_(std::make_shared<couvreur99_new_status<is_explicit>>(a))
+        , lossy_(lossy_state_set::from_options(o))
       {
         if (a->acc().uses_fin_acceptance())
           throw std::runtime_error
@@ -598,7 +617,33 @@ namespace spot
         return check_impl<true>()->accepting_run();
       }
 
+      virtual std::ostream&
+      print_stats(std::ostream& os) const override
+      {
+        if (lossy_)
+          {
+            os << states() << " unique states visited\n";
+            os << coverage() * 100 << "% estimated coverage\n";
+          }
+        return os;
+      }
+
+      virtual bool safe() const override
+      {
+        return !lossy_;
+      }
+
     private:
+      void
+      update_stats()
+      {
+        if (lossy_)
+          {
+            set_states(lossy_->size());
+            set_coverage(lossy_->coverage());
+          }
+      }
+
       // A union-like struct to store the result of an emptiness.
       // If the caller only wants to test emptiness, it is sufficient to
       // store the Boolean result.
@@ -696,6 +741,8 @@ namespace spot
         {
           state_t init = T::initial_state(ecs_->aut);
           ecs_->h[init] = 1;
+          if (lossy_)
+            lossy_->insert(T::to_state(ecs_->aut, init));
           ecs_->root.push(1);
           if (strength == STRONG)
             arc.push({});
@@ -738,14 +785,22 @@ namespace spot
                     assert(i != live.rend());
                     ++i; // Because base() does -1
                     for (auto it = i.base(); it != live.end(); ++it)
-                    {
-                      ecs_->h[*it] = -1;
-                    }
+                      if (lossy_)
+                        {
+                          // Only the lossy set remembers dead states.
+                          T::h_erase(ecs_->h, *it);
+                          T::destroy(*it);
+                        }
+                      else
+                        {
+                          ecs_->h[*it] = -1;
+                        }
                     live.erase(i.base(), live.end());
                     ecs_->root.pop();
                   }
                 T::it_destroy(ecs_->aut, succ);
-                // Do not destroy curr: it is a key in h.
+                // Do not destroy curr: it is a key in h (or it was
+                // destroyed with its SCC when lossy_ is used).
                 continue;
               }
 
@@ -772,6 +827,7 @@ namespace spot
                       todo.pop();
                       dec_depth();
                     }
+                  update_stats();
                   // We do not need an accepting run.
                   return true;
                 }
@@ -784,6 +840,14 @@ namespace spot
 
             // Are we going to a new state?
             auto p = T::h_emplace(ecs_->h, dest, num+1);
+            if (p.second && lossy_
+                && !lossy_->insert(T::to_state(ecs_->aut, dest)).second)
+              {
+                // DEST is (probably) part of a dead SCC.
+                T::h_erase(ecs_->h, dest);
+                T::destroy(dest);
+                continue;
+              }
             if (p.second)
               {
                 // Yes.  Bump number, stack the stack, and register its
@@ -849,7 +913,7 @@ namespace spot
                 // Use this state to start the computation of an
                 // accepting cycle.
                 ecs_->cycle_seed = p.first.first;
-                set_states(states());
+                update_stats();
                 if (need_accepting_run)
                   return check_result(
                     std::make_shared<couvreur99_new_result<is_explicit>>(ecs_));
@@ -858,7 +922,7 @@ namespace spot
               }
           }
         // This automaton recognizes no word.
-        set_states(states());
+        update_stats();
         return nullptr;
       }
     };
@@ -885,7 +949,8 @@ namespace spot
   get_couvreur99_new(const const_twa_ptr& a, spot::option_map o)
   {
     const_twa_graph_ptr ag = std::dynamic_pointer_cast<const twa_graph>(a);
-    if (ag) // the automaton is explicit
+    // Lossy state sets are only supported by the abstract version.
+    if (ag && !o.get("hc") && !o.get("bsh")) // the automaton is explicit
       {
         // NB: The order of the if's matter.
         if (a->prop_terminal())
@@ -906,4 +971,104 @@ namespace spot
     return get_couvreur99_new(a, spot::option_map())->check();
   }
 
+  bool
+  couvreur99_new_is_empty(const const_handle_twa_ptr& a)
+  {
+    const acc_cond& acc = a->acc();
+    if (acc.uses_fin_acceptance())
+      throw std::runtime_error
+        ("couvreur99_new requires Fin-less acceptance");
+    if (acc.is_f())
+      return true;
+
+    // The order of each visited state, 0 for unvisited states, and -1
+    // for states of dead SCCs.
+    std::vector<int> h;
+    // The successors of the states of todo, stored consecutively.
+    std::vector<handle_succ> succs;
+    struct todo_item
+    {
+      state_handle s;
+      unsigned begin;           // first successor in succs
+      unsigned pos;             // next successor to visit
+    };
+    std::vector<todo_item> todo;
+    std::vector<scc> root;
+    std::vector<acc_cond::mark_t> arc;
+    std::vector<state_handle> live;
+    int num = 0;
+
+    auto push = [&](state_handle s, acc_cond::mark_t in)
+      {
+        h[s] = ++num;
+        root.emplace_back(num);
+        arc.push_back(in);
+        unsigned begin = succs.size();
+        a->succ(s, succs);
+        // The new successors may have new handles.
+        if (h.size() < a->num_states())
+          h.resize(a->num_states());
+        todo.push_back({s, begin, begin});
+        live.push_back(s);
+      };
+
+    state_handle init = a->get_init_state();
+    h.resize(a->num_states());
+    push(init, {});
+
+    while (!todo.empty())
+      {
+        todo_item& t = todo.back();
+        if (t.pos == succs.size())
+          {
+            // All successors have been explored, backtrack.
+            state_handle curr = t.s;
+            succs.resize(t.begin);
+            todo.pop_back();
+            if (root.back().index == h[curr])
+              {
+                // CURR is the root of an SCC, which is now dead.
+                state_handle s;
+                do
+                  {
+                    s = live.back();
+                    live.pop_back();
+                    h[s] = -1;
+                  }
+                while (s != curr);
+                root.pop_back();
+                arc.pop_back();
+              }
+            continue;
+          }
+
+        const handle_succ& e = succs[t.pos++];
+        if (SPOT_UNLIKELY(e.cond == bddfalse))
+          continue;
+        state_handle dst = e.dst;
+        acc_cond::mark_t m = e.acc;
+        int hd = h[dst];
+        if (hd == 0)
+          {
+            push(dst, m);
+            continue;
+          }
+        if (hd == -1)
+          continue;
+        // DST belongs to an SCC of the DFS stack: merge all the SCCs
+        // above it.
+        while (hd < root.back().index)
+          {
+            m |= root.back().condition;
+            m |= arc.back();
+            root.pop_back();
+            arc.pop_back();
+          }
+        root.back().condition |= m;
+        if (acc.accepting(root.back().condition))
+          return false;
+      }
+    return true;
+  }
+
 } // namespace spot
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <spot/twa/twahandle.hh>
 #include <spot/twaalgos/emptiness.hh>
 
 namespace spot
@@ -27,6 +28,10 @@ namespace spot
   /// It is optimized to run on explicit automata (avoiding the memory
   /// allocations of the virtual, abstract interface.
   /// It also has specializations for weak and terminal automata.
+  ///
+  /// If option \c "hc" or \c "bsh" is set in \a o, the states of
+  /// the SCCs that have been fully explored are stored in a
+  /// lossy_state_set.  The abstract interface is then always used.
   SPOT_API
   emptiness_check_ptr
   get_couvreur99_new(const const_twa_ptr& a, option_map o);
@@ -46,4 +51,16 @@ namespace spot
   SPOT_API
   emptiness_check_result_ptr
   couvreur99_new_check(const const_twa_ptr& a);
+
+  /// \brief Check the emptiness of an automaton with state handles.
+  ///
+  /// This runs the same algorithm on a handle_twa, using vectors
+  /// indexed by the state handles instead of hash tables, so that
+  /// no state is cloned or destroyed during the search.  Only the
+  /// emptiness of the language is computed, not an accepting run.
+  ///
+  /// \return true iff the language of \a a is empty.
+  SPOT_API
+  bool
+  couvreur99_new_is_empty(const const_handle_twa_ptr& a);
 }
@@ -25,8 +25,11 @@
 #include <unordered_map>
 #include <set>
 #include <map>
+#include <memory>
+#include <cstring>
 
 #include <spot/misc/bddlt.hh>
+#include <spot/misc/hashfunc.hh>
 #include <spot/twaalgos/sccinfo.hh>
 #include <spot/twaalgos/determinize.hh>
 #include <spot/twaalgos/degen.hh>
@@ -88,7 +91,6 @@ namespace spot
 
     bool operator<(const safra_state&) const;
     bool operator==(const safra_state&) const;
-    size_t hash() const;
 
     // Print the number of states in each brace
     // default constructor
@@ -113,28 +115,167 @@ namespace spot
 
   namespace
   {
-    struct hash_safra
+    // Store the safra_states that have been seen, and associate each
+    // of them to a state number of the output automaton.
+    //
+    // Keeping each safra_state as a pair of std::vector costs a lot
+    // of memory (two heap allocations, plus the vector headers, plus
+    // 8 bytes per node).  Instead, each state is packed as a
+    // variable-length string of bytes (LEB128-encoded integers),
+    // stored in a private arena.  The hash of that string is computed
+    // once when it is packed, and kept alongside the pointer, so that
+    // lookups never rehash the structure, and equality tests reduce
+    // to a memcmp().
+    class safra_table final
     {
-      size_t
-      operator()(const safra_state& s) const noexcept
+      struct packed
       {
-        return s.hash();
+        const unsigned char* data;
+        unsigned size;
+        unsigned hash;
+      };
+
+      struct packed_hash
+      {
+        size_t
+        operator()(const packed& p) const noexcept
+        {
+          return p.hash;
+        }
+      };
+
+      struct packed_equal
+      {
+        bool
+        operator()(const packed& l, const packed& r) const noexcept
+        {
+          return l.size == r.size && !memcmp(l.data, r.data, l.size);
+        }
+      };
+
+      robin_hood::unordered_flat_map<packed, unsigned,
+                                     packed_hash, packed_equal> map_;
+      // packed states, indexed by their number
+      std::vector<packed> states_;
+      // arena where the packed states are stored
+      std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+      unsigned char* free_start_ = nullptr;
+      unsigned char* free_end_ = nullptr;
+      // scratch buffer used to pack states
+      mutable std::vector<unsigned char> buf_;
+
+      static void
+      put_varint(std::vector<unsigned char>& buf, unsigned v)
+      {
+        while (v >= 0x80)
+          {
+            buf.push_back(v | 0x80);
+            v >>= 7;
+          }
+        buf.push_back(v);
+      }
+
+      static unsigned
+      get_varint(const unsigned char*& p)
+      {
+        unsigned v = 0;
+        unsigned shift = 0;
+        unsigned char c;
+        do
+          {
+            c = *p++;
+            v |= (c & 0x7f) << shift;
+            shift += 7;
+          }
+        while (c & 0x80);
+        return v;
+      }
+
+      // Pack s into buf_, and return a key pointing into buf_.
+      packed
+      pack(const safra_state& s) const
+      {
+        buf_.clear();
+        put_varint(buf_, s.nodes_.size());
+        put_varint(buf_, s.braces_.size());
+        // Braces are >= -1, so we shift them by one to store
+        // non-negative values.
+        for (const auto& n: s.nodes_)
+          {
+            put_varint(buf_, n.first);
+            put_varint(buf_, n.second + 1);
+          }
+        for (int b: s.braces_)
+          put_varint(buf_, b + 1);
+        return packed{buf_.data(), static_cast<unsigned>(buf_.size()),
+                      static_cast<unsigned>(fnv_hash(buf_.begin(),
+                                                     buf_.end()))};
+      }
+
+      const unsigned char*
+      store(const packed& p)
+      {
+        if (free_start_ + p.size > free_end_)
+          {
+            size_t requested = std::max<size_t>(p.size, 65536);
+            chunks_.emplace_back(new unsigned char[requested]);
+            free_start_ = chunks_.back().get();
+            free_end_ = free_start_ + requested;
+          }
+        unsigned char* res = free_start_;
+        free_start_ += p.size;
+        memcpy(res, p.data, p.size);
+        return res;
+      }
+
+    public:
+      // Return the number associated to s.  If s was not yet in the
+      // table, it is inserted with number size(), and the second
+      // member of the returned pair is true.
+      std::pair<unsigned, bool>
+      emplace(const safra_state& s)
+      {
+        packed p = pack(s);
+        auto it = map_.find(p);
+        if (it != map_.end())
+          return {it->second, false};
+        p.data = store(p);
+        unsigned num = states_.size();
+        states_.emplace_back(p);
+        map_.emplace(p, num);
+        return {num, true};
       }
-    };
 
-    template<class T>
-    struct ref_wrap_equal
-    {
       bool
-      operator()(const std::reference_wrapper<T>& x,
-                 const std::reference_wrapper<T>& y) const
+      contains(const safra_state& s) const
       {
-        return std::equal_to<T>()(x.get(), y.get());
+        return map_.find(pack(s)) != map_.end();
+      }
+
+      // Decode state number num into s.
+      void
+      get(unsigned num, safra_state& s) const
+      {
+        const unsigned char* p = states_[num].data;
+        unsigned nodes = get_varint(p);
+        unsigned braces = get_varint(p);
+        s.nodes_.resize(nodes);
+        for (auto& n: s.nodes_)
+          {
+            n.first = get_varint(p);
+            n.second = static_cast<int>(get_varint(p)) - 1;
+          }
+        s.braces_.resize(braces);
+        for (int& b: s.braces_)
+          b = static_cast<int>(get_varint(p)) - 1;
       }
-    };
 
-    using power_set =
-      robin_hood::unordered_node_map<safra_state, unsigned, hash_safra>;
+      unsigned
+      size() const
+      {
+        return states_.size();
+      }
+    };
 
     std::string
     nodes_to_string(const const_twa_graph_ptr& aut,
@@ -254,7 +395,7 @@ namespace spot
       const safra_state* src;
       const std::vector<bdd>* all_bdds;
       const const_twa_graph_ptr& aut;
-      const power_set& seen;
+      const safra_table& seen;
       const scc_info& scc;
       const std::vector<std::vector<char>>& implies;
       bool use_scc;
@@ -269,7 +410,7 @@ namespace spot
 
     public:
       compute_succs(const const_twa_graph_ptr& aut,
-                    const power_set& seen,
+                    const safra_table& seen,
                     const scc_info& scc,
                     const std::vector<std::vector<char>>& implies,
                     bool use_scc,
@@ -379,15 +520,14 @@ namespace spot
                   ss = stutter_path_.back().compute_succ(cs_, ap, color_);
                   mincolor = std::min(color_, mincolor);
                 }
-              bool in_seen = cs_.seen.find(*cycle_seed) != cs_.seen.end();
+              bool in_seen = cs_.seen.contains(*cycle_seed);
               for (auto it = cycle_seed + 1; it < stutter_path_.end(); ++it)
                 {
                   if (in_seen)
                     {
                       // if *cycle_seed is already in seen, replace
                       // it with a smaller state also in seen.
-                      if (cs_.seen.find(*it) != cs_.seen.end()
-                          && *it < *cycle_seed)
+                      if (cs_.seen.contains(*it) && *it < *cycle_seed)
                         cycle_seed = it;
                     }
                   else
@@ -395,7 +535,7 @@ namespace spot
                       // if *cycle_seed is not in seen, replace it
                       // either with a state in seen or with a smaller
                       // state
-                      if (cs_.seen.find(*it) != cs_.seen.end())
+                      if (cs_.seen.contains(*it))
                         {
                           cycle_seed = it;
                           in_seen = true;
@@ -539,11 +679,16 @@ namespace spot
 
     std::vector<std::string>*
     print_debug(const const_twa_graph_ptr& aut,
-                const power_set& states)
+                const safra_table& states)
     {
-      auto res = new std::vector<std::string>(states.size());
-      for (const auto& p: states)
-        (*res)[p.second] = nodes_to_string(aut, p.first);
+      unsigned n = states.size();
+      auto res = new std::vector<std::string>(n);
+      safra_state s;
+      for (unsigned i = 0; i < n; ++i)
+        {
+          states.get(i, s);
+          (*res)[i] = nodes_to_string(aut, s);
+        }
       return res;
     }
 
@@ -760,27 +905,6 @@ namespace spot
     return braces_ == other.braces_ ? nodes_ < other.nodes_
                                     : braces_ < other.braces_;
   }
-  size_t
-  safra_state::hash() const
-  {
-    size_t res = 0;
-    //std::cerr << this << " [";
-    for (const auto& p : nodes_)
-      {
-        res ^= (res << 3) ^ p.first;
-        res ^= (res << 3) ^ p.second;
-        //  std::cerr << '(' << p.first << ',' << p.second << ')';
-      }
-    //    std::cerr << "][ ";
-    for (const auto& b : braces_)
-      {
-        res ^= (res << 3) ^ b;
-        //  std::cerr << b << ' ';
-      }
-    //    std::cerr << "]: " << std::hex << res << std::dec << '\n';
-    return res;
-  }
-
   bool
   safra_state::operator==(const safra_state& other) const
   {
@@ -932,20 +1056,19 @@ namespace spot
 
     // Given a safra_state get its associated state in output automata.
     // Required to create new edges from 2 safra-state
-    power_set seen;
-    // As per the standard, references to elements in a std::unordered_set or
-    // std::unordered_map are invalidated by erasure only.
-    std::deque<std::reference_wrapper<power_set::value_type>> todo;
+    safra_table seen;
+    std::deque<unsigned> todo;
     auto get_state = [&res, &seen, &todo](const safra_state& s) -> unsigned
       {
-        auto it = seen.find(s);
-        if (it == seen.end())
+        auto p = seen.emplace(s);
+        if (p.second)
           {
             unsigned dst_num = res->new_state();
-            it = seen.emplace(s, dst_num).first;
-            todo.emplace_back(*it);
+            assert(dst_num == p.first);
+            (void) dst_num;
+            todo.emplace_back(p.first);
           }
-        return it->second;
+        return p.first;
       };
 
     {
@@ -960,14 +1083,15 @@ namespace spot
 
     compute_succs succs(aut, seen, scc, implies, use_scc, use_simulation,
                         use_stutter);
+    safra_state curr;
     // The main loop
     while (!todo.empty())
       {
         if (aborter && aborter->too_large(res))
           return nullptr;
-        const safra_state& curr = todo.front().get().first;
-        unsigned src_num = todo.front().get().second;
+        unsigned src_num = todo.front();
         todo.pop_front();
+        seen.get(src_num, curr);
         succs.set(curr, safra2letters.get(curr));
         for (auto s = succs.begin(); s != succs.end(); ++s)
           {
@@ -23,6 +23,7 @@
 #include "config.h"
 #include <sstream>
 #include <memory>
+#include <stdexcept>
 #include <spot/twaalgos/emptiness.hh>
 #include <spot/twaalgos/bfssteps.hh>
 #include <spot/twaalgos/couvreurnew.hh>
@@ -119,6 +120,9 @@ namespace spot
 
   namespace
   {
+    // Lossy state stores supported by an algorithm.
+    enum { lossy_none = 0, lossy_hc = 1, lossy_bsh = 2 };
+
     struct ec_algo
     {
       const char* name;
@@ -126,18 +130,22 @@ namespace spot
                                       spot::option_map);
       unsigned int min_acc;
       unsigned int max_acc;
+      unsigned int lossy;
     };
 
     ec_algo ec_algos[] =
       {
-        { "Cou99",     couvreur99,                    0, -1U },
-        { "Cou99new",  get_couvreur99_new,            0, -1U },
-        { "Cou99abs",  get_couvreur99_new_abstract,   0, -1U },
-        { "CVWY90",    magic_search,                  0,   1 },
-        { "GV04",      explicit_gv04_check,           0,   1 },
-        { "SE05",      se05,                          0,   1 },
-        { "Tau03",     explicit_tau03_search,         1, -1U },
-        { "Tau03_opt", explicit_tau03_opt_search,     0, -1U },
+        { "Cou99",     couvreur99,                    0, -1U, lossy_none },
+        { "Cou99new",  get_couvreur99_new,            0, -1U,
+          lossy_hc | lossy_bsh },
+        { "Cou99abs",  get_couvreur99_new_abstract,   0, -1U,
+          lossy_hc | lossy_bsh },
+        { "CVWY90",    magic_search,                  0,   1, lossy_bsh },
+        { "GV04",      explicit_gv04_check,           0,   1,
+          lossy_hc | lossy_bsh },
+        { "SE05",      se05,                          0,   1, lossy_bsh },
+        { "Tau03",     explicit_tau03_search,         1, -1U, lossy_hc },
+        { "Tau03_opt", explicit_tau03_opt_search,     0, -1U, lossy_none },
       };
   }
 
@@ -162,7 +170,14 @@ namespace spot
   emptiness_check_ptr
   emptiness_check_instantiator::instantiate(const const_twa_ptr& a) const
   {
-    return static_cast<ec_algo*>(info_)->construct(a, o_);
+    ec_algo* info = static_cast<ec_algo*>(info_);
+    if (o_.get("hc") && !(info->lossy & lossy_hc))
+      throw std::runtime_error(std::string(info->name)
+                               + " does not support option hc");
+    if (o_.get("bsh") && !(info->lossy & lossy_bsh))
+      throw std::runtime_error(std::string(info->name)
+                               + " does not support option bsh");
+    return info->construct(a, o_);
   }
 
   emptiness_check_instantiator_ptr
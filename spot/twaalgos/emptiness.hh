@@ -294,19 +294,35 @@ namespace spot
   ///   Cou99(poprem shy group)
   ///   \endcode
   ///
-  /// - `GC04` uses `spot::explicit_gv04_check()` and works on automata
+  /// - `Cou99new` uses `spot::get_couvreur99_new()`, and `Cou99abs`
+  ///   uses `spot::get_couvreur99_new_abstract()`.  Both work with
+  ///   Fin-less acceptance conditions, with any number of acceptance
+  ///   sets.  Set option `hc` to a number of bits to activate hash
+  ///   compaction, or option `bsh` to the size of a bit array to
+  ///   activate bit-state hashing (see spot::lossy_state_set).
+  ///
+  ///   Examples:
+  ///   \code
+  ///   Cou99new
+  ///   Cou99new(hc=40)
+  ///   Cou99abs(bsh=4M)
+  ///   \endcode
+  ///
+  /// - `GV04` uses `spot::explicit_gv04_check()` and works on automata
   ///   with Fin-less acceptance conditions using at most one acceptance
-  ///   set.  No options are supported.
+  ///   set.  Options `hc` and `bsh` are supported as for `Cou99new`.
   ///
-  ///   Example:
+  ///   Examples:
   ///   \code
-  ///   GC04
+  ///   GV04
+  ///   GV04(hc=40)
   ///   \endcode
   ///
   /// - `CVWY90` uses `spot::magic_search()` and work on automata with
   ///   Fin-less acceptance conditions using at most one acceptance
   ///   set.  Set option `bsh` to the size of a hash-table if you want
-  ///   to activate bit-state hashing.
+  ///   to activate bit-state hashing, and option `hash_seed` to change
+  ///   the hash function it uses.
   ///
   ///   Examples:
   ///   \code
@@ -317,7 +333,8 @@ namespace spot
   /// - `SE05` uses `spot::se05()` and works on work on automata with
   ///   Fin-less acceptance conditions using at most one acceptance
   ///   set.  Set option `bsh` to the size of a hash-table if you want
-  ///   to activate bit-state hashing.
+  ///   to activate bit-state hashing, and option `hash_seed` to change
+  ///   the hash function it uses.
   ///
   ///   Examples:
   ///   \code
@@ -327,11 +344,13 @@ namespace spot
   ///
   /// - `Tau03` uses `spot::explicit_tau03_search()` and work on automata with
   ///   Fin-less acceptance conditions using at least one acceptance
-  ///   set.  No options are supported.
+  ///   set.  Set option `hc` to a number of bits to activate hash
+  ///   compaction.
   ///
-  ///   Example:
+  ///   Examples:
   ///   \code
   ///   Tau03
+  ///   Tau03(hc=40)
   ///   \endcode
   ///
   /// - `Tau03_opt` uses `spot::explicit_tau03_opt_search()` and work on
@@ -130,11 +130,29 @@ namespace spot
       return depth_;
     }
 
+    void
+    set_coverage(double c)
+    {
+      coverage_ = c;
+    }
+
+    /// \brief Estimated fraction of the reachable states that were
+    /// actually explored.
+    ///
+    /// This is 1, unless visited states are stored in a
+    /// lossy_state_set.
+    double
+    coverage() const
+    {
+      return coverage_;
+    }
+
   private :
     unsigned states_;                /// number of disctint visited states
     unsigned transitions_;        /// number of visited transitions
     unsigned depth_;                /// maximal depth of the stack(s)
     unsigned max_depth_;        /// maximal depth of the stack(s)
+    double coverage_ = 1.0;        /// estimated coverage of the search
   };
 
   /// \brief Accepting Run Search statistics.
@@ -39,6 +39,7 @@
 #include <spot/twaalgos/emptiness_stats.hh>
 #include <spot/twaalgos/gv04.hh>
 #include <spot/twaalgos/bfssteps.hh>
+#include <spot/twaalgos/lossyset.hh>
 
 namespace spot
 {
@@ -55,9 +56,13 @@ namespace spot
 
     struct gv04: public emptiness_check, public ec_statistics
     {
-      // Map of visited states.
+      // Map of visited states.  If states are stored in a lossy set,
+      // this only holds the states that are on the stack.
       state_map<size_t> h;
 
+      // Lossy set of visited states, if requested by the options.
+      std::unique_ptr<lossy_state_set> lossy;
+
       // Stack of visited states on the path.
       std::vector<stack_entry> stack;
 
@@ -66,7 +71,7 @@ namespace spot
       bool violation;                // Whether an accepting run was found.
 
       gv04(const const_twa_ptr& a, option_map o)
-        : emptiness_check(a, o)
+        : emptiness_check(a, o), lossy(lossy_state_set::from_options(o))
       {
         if (!(a->prop_weak().is_true()
               || a->num_sets() == 0
@@ -94,7 +99,10 @@ namespace spot
       {
         top = dftop = -1;
         violation = false;
-        push(a_->get_init_state(), false);
+        const state* init = a_->get_init_state();
+        if (lossy)
+          lossy->insert(init);
+        push(init, false);
 
         while (!violation && dftop >= 0)
           {
@@ -139,8 +147,17 @@ namespace spot
 
                 if (i == h.end())
                   {
-                    trace << " is a new state." << std::endl;
-                    push(s_prime, acc);
+                    if (lossy && !lossy->insert(s_prime).second)
+                      {
+                        trace << " is (probably) no longer on stack."
+                              << std::endl;
+                        s_prime->destroy();
+                      }
+                    else
+                      {
+                        trace << " is a new state." << std::endl;
+                        push(s_prime, acc);
+                      }
                   }
                 else
                   {
@@ -162,8 +179,10 @@ namespace spot
                     s_prime->destroy();
                   }
               }
-            set_states(h.size());
+            set_states(lossy ? lossy->size() : h.size());
           }
+        if (lossy)
+          set_coverage(lossy->coverage());
         if (violation)
           return std::make_shared<result>(*this);
         return nullptr;
@@ -208,6 +227,11 @@ namespace spot
             for (int i = top; i >= dftop; --i)
               {
                 a_->release_iter(stack[i].lasttr);
+                if (lossy)
+                  {
+                    h.erase(stack[i].s);
+                    stack[i].s->destroy();
+                  }
                 stack.pop_back();
                 dec_depth();
               }
@@ -237,12 +261,19 @@ namespace spot
       virtual std::ostream&
       print_stats(std::ostream& os) const override
       {
-        os << h.size() << " unique states visited\n";
+        os << states() << " unique states visited\n";
         os << transitions() << " transitions explored\n";
         os << max_depth() << " items max on stack\n";
+        if (lossy)
+          os << coverage() * 100 << "% estimated coverage\n";
         return os;
       }
 
+      virtual bool safe() const override
+      {
+        return !lossy;
+      }
+
       struct result:
         public emptiness_check_result,
         public acss_statistics
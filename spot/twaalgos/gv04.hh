@@ -36,6 +36,9 @@ namespace spot
   /// The original algorithm, coming from \cite geldenhuys.04.tacas ,
   /// has only been slightly modified to work on transition-based
   /// automata.
+  ///
+  /// If option \c "hc" or \c "bsh" is set in \a o, the states that
+  /// are no longer on the stack are stored in a lossy_state_set.
   SPOT_API emptiness_check_ptr
   explicit_gv04_check(const const_twa_ptr& a, option_map o = option_map());
 }
@@ -0,0 +1,219 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/twaalgos/lossyset.hh>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace spot
+{
+  namespace
+  {
+    // The finalizer of MurmurHash3, to spread the bits of hash
+    // values that are often small integers.
+    static uint64_t
+    mix64(uint64_t x)
+    {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+  }
+
+  constexpr unsigned lossy_state_set::npos;
+  constexpr unsigned lossy_state_set::hash_bits;
+
+  lossy_state_set::lossy_state_set(store_type type, size_t size,
+                                   unsigned hashes, unsigned seed)
+    : type_(type), hashes_(hashes), seed_(seed * 0x9e3779b97f4a7c15ULL)
+  {
+    if (type == hash_compaction)
+      {
+        if (size < 1 || size > 64)
+          throw std::runtime_error("hash compaction requires between "
+                                   "1 and 64 bits");
+        bits_ = size;
+      }
+    else
+      {
+        if (size < 1)
+          throw std::runtime_error("bit-state hashing requires "
+                                   "a non-empty array");
+        if (hashes < 1 || hashes > 64)
+          throw std::runtime_error("bit-state hashing requires between "
+                                   "1 and 64 hash functions");
+        nbits_ = size * 8;
+        data_.resize((size + 7) / 8, 0);
+      }
+  }
+
+  std::unique_ptr<lossy_state_set>
+  lossy_state_set::from_options(const option_map& o)
+  {
+    int hc = o.get("hc");
+    int bsh = o.get("bsh");
+    if (hc && bsh)
+      throw std::runtime_error("options hc and bsh are incompatible");
+    if (hc)
+      return std::unique_ptr<lossy_state_set>
+        (new lossy_state_set(hash_compaction, hc, 0, o.get("hash_seed")));
+    if (bsh)
+      return std::unique_ptr<lossy_state_set>
+        (new lossy_state_set(bitstate, bsh, o.get("bsh_hashes", 3),
+                             o.get("hash_seed")));
+    return nullptr;
+  }
+
+  uint64_t
+  lossy_state_set::hash(const state* s) const
+  {
+    return mix64(s->hash() ^ seed_);
+  }
+
+  uint64_t
+  lossy_state_set::fingerprint(const state* s) const
+  {
+    uint64_t h = hash(s);
+    return bits_ == 64 ? h : h >> (64 - bits_);
+  }
+
+  double
+  lossy_state_set::false_positive_rate() const
+  {
+    // A new state is also confused with a visited one if they have
+    // the same state::hash(), which we assume to have only hash_bits
+    // significant bits.  Wider fingerprints cannot help then.
+    if (type_ == hash_compaction)
+      return std::ldexp(static_cast<double>(count_),
+                        -static_cast<int>(std::min(bits_, hash_bits)));
+    double p = std::pow(static_cast<double>(ones_) / nbits_, hashes_);
+    double q = std::ldexp(static_cast<double>(count_),
+                          -static_cast<int>(hash_bits));
+    return p + q - p * q;
+  }
+
+  void
+  lossy_state_set::grow()
+  {
+    unsigned nb = buckets_.empty() ? 1024 : 2 * buckets_.size();
+    buckets_.assign(nb, 0);
+    unsigned mask = nb - 1;
+    for (unsigned i = 0, n = data_.size(); i < n; ++i)
+      {
+        unsigned b = data_[i] & mask;
+        while (buckets_[b])
+          b = (b + 1) & mask;
+        buckets_[b] = i + 1;
+      }
+  }
+
+  std::pair<unsigned, bool>
+  lossy_state_set::insert(const state* s)
+  {
+    // The probability that a new state would be wrongly rejected.
+    // Each accepted state accounts for 1/(1-p) new states, of which
+    // p/(1-p) are expected to have been rejected.
+    double p = false_positive_rate();
+    if (type_ == hash_compaction)
+      {
+        // Fingerprints are already mixed, so their low bits can be
+        // used to select a bucket.
+        uint64_t fp = fingerprint(s);
+        if (2 * (data_.size() + 1) > buckets_.size())
+          {
+            if (SPOT_UNLIKELY(data_.size() >= -1U / 4))
+              throw std::runtime_error("lossy_state_set: too many states");
+            grow();
+          }
+        unsigned mask = buckets_.size() - 1;
+        unsigned b = fp & mask;
+        while (unsigned i = buckets_[b])
+          {
+            if (data_[i - 1] == fp)
+              return {i - 1, false};
+            b = (b + 1) & mask;
+          }
+        unsigned res = data_.size();
+        data_.push_back(fp);
+        buckets_[b] = res + 1;
+        ++count_;
+        if (p < 1.0)
+          omissions_ += p / (1.0 - p);
+        return {res, true};
+      }
+
+    uint64_t h1 = hash(s);
+    uint64_t h2 = mix64(h1 + 0x9e3779b97f4a7c15ULL) | 1;
+    bool is_new = false;
+    for (unsigned i = 0; i < hashes_; ++i)
+      {
+        uint64_t pos = (h1 + i * h2) % nbits_;
+        uint64_t& w = data_[pos / 64];
+        uint64_t m = uint64_t(1) << (pos % 64);
+        if (!(w & m))
+          {
+            w |= m;
+            ++ones_;
+            is_new = true;
+          }
+      }
+    if (is_new)
+      {
+        ++count_;
+        if (p < 1.0)
+          omissions_ += p / (1.0 - p);
+      }
+    return {0, is_new};
+  }
+
+  unsigned
+  lossy_state_set::find(const state* s) const
+  {
+    if (type_ == hash_compaction)
+      {
+        if (buckets_.empty())
+          return npos;
+        uint64_t fp = fingerprint(s);
+        unsigned mask = buckets_.size() - 1;
+        unsigned b = fp & mask;
+        while (unsigned i = buckets_[b])
+          {
+            if (data_[i - 1] == fp)
+              return i - 1;
+            b = (b + 1) & mask;
+          }
+        return npos;
+      }
+
+    uint64_t h1 = hash(s);
+    uint64_t h2 = mix64(h1 + 0x9e3779b97f4a7c15ULL) | 1;
+    for (unsigned i = 0; i < hashes_; ++i)
+      {
+        uint64_t pos = (h1 + i * h2) % nbits_;
+        if (!(data_[pos / 64] & (uint64_t(1) << (pos % 64))))
+          return npos;
+      }
+    return 0;
+  }
+}
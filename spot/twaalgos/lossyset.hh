@@ -0,0 +1,160 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/misc/optionmap.hh>
+#include <spot/twa/twa.hh>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup emptiness_check
+  /// \brief A lossy set of visited states.
+  ///
+  /// Such a set does not store the states, but only some bits
+  /// derived from their hash value, so that emptiness checks can
+  /// explore state spaces that would not fit in memory otherwise.
+  /// Two states with the same bits are confused: the second one is
+  /// considered as already visited, and the part of the state space
+  /// that is only reachable from it may be missed.  Any
+  /// counterexample found is still genuine, but the absence of
+  /// counterexamples is only probable.
+  ///
+  /// Two stores are supported:
+  /// - hash compaction keeps a fingerprint of \a bits bits for each
+  ///   state, in a hash table;
+  /// - bit-state hashing sets \a hashes bits of a fixed-size bit
+  ///   array for each state, as in a Bloom filter.
+  ///
+  /// The bits are derived from state::hash(), so states that have
+  /// the same hash() are always confused, whatever the number of
+  /// bits of the fingerprint.
+  ///
+  /// Each insertion of a new state updates an estimate of the number
+  /// of states that were wrongly considered as visited.  Because
+  /// many implementations of state::hash() (e.g., those of products
+  /// and of PINS models) return only 32 significant bits, this
+  /// estimate assumes that states are distinguished by at most 32
+  /// bits: fingerprints larger than 32 bits are accepted, but do not
+  /// make the estimate better than with 32 bits.
+  class SPOT_API lossy_state_set final
+  {
+  public:
+    enum store_type { hash_compaction, bitstate };
+
+    /// Returned by find() for absent states.
+    static constexpr unsigned npos = -1U;
+
+    /// \brief Create a lossy set.
+    ///
+    /// With \a type = hash_compaction, \a size is the number of bits
+    /// of the fingerprints (from 1 to 64) and \a hashes is ignored.
+    /// With \a type = bitstate, \a size is the size of the bit array
+    /// in bytes, and \a hashes the number of bits set for each
+    /// state.  An std::runtime_error is thrown if these values are
+    /// out of range.  Sets created with different \a seed values
+    /// confuse different states.
+    lossy_state_set(store_type type, size_t size, unsigned hashes = 3,
+                    unsigned seed = 0);
+
+    /// \brief Create the lossy set requested by the options of an
+    /// emptiness check.
+    ///
+    /// Option `hc=BITS` selects hash compaction with \a BITS bits,
+    /// while `bsh=SIZE` selects bit-state hashing with an array of
+    /// \a SIZE bytes, and `bsh_hashes=K` (default 3) the number of
+    /// bits to set for each state.  Option `hash_seed` gives the
+    /// \a seed of the set.  Return nullptr if neither `hc` nor `bsh`
+    /// is set, i.e., if states should be stored exactly.
+    static std::unique_ptr<lossy_state_set>
+    from_options(const option_map& o);
+
+    /// The type of store.
+    store_type type() const
+    {
+      return type_;
+    }
+
+    /// \brief Insert \a s in the set.
+    ///
+    /// The state \a s is not stored, and remains owned by the caller.
+    /// The second member of the result is true if \a s was considered
+    /// new.  With hash compaction, the first member is the number of
+    /// the fingerprint of \a s: fingerprints are numbered
+    /// consecutively from 0 in the order of insertion.  With bit-state
+    /// hashing, it is always 0.
+    std::pair<unsigned, bool> insert(const state* s);
+
+    /// \brief Look \a s up.
+    ///
+    /// Return the number of the fingerprint of \a s (or 0 with
+    /// bit-state hashing) if \a s is considered as visited, and npos
+    /// otherwise.
+    unsigned find(const state* s) const;
+
+    /// The number of states that were inserted as new.
+    size_t size() const
+    {
+      return count_;
+    }
+
+    /// \brief The expected number of states that were wrongly
+    /// considered as visited so far.
+    ///
+    /// This assumes that state::hash() has 32 significant bits.
+    double expected_omissions() const
+    {
+      return omissions_;
+    }
+
+    /// \brief The expected fraction of the states that were actually
+    /// visited, between 0 and 1.
+    double coverage() const
+    {
+      return count_ ? count_ / (count_ + omissions_) : 1.0;
+    }
+
+  private:
+    uint64_t hash(const state* s) const;
+    uint64_t fingerprint(const state* s) const;
+    double false_positive_rate() const;
+
+    // The number of significant bits assumed for state::hash() in
+    // false_positive_rate().
+    static constexpr unsigned hash_bits = 32;
+    void grow();
+
+    store_type type_;
+    unsigned bits_ = 0;            // fingerprint size (hash compaction)
+    size_t nbits_ = 0;             // array size (bit-state hashing)
+    unsigned hashes_;
+    uint64_t seed_;
+    size_t count_ = 0;
+    double omissions_ = 0.0;
+    // Bit array for bit-state hashing, or fingerprints in insertion
+    // order for hash compaction.
+    std::vector<uint64_t> data_;
+    size_t ones_ = 0;              // bits set in data_ (bit-state hashing)
+    std::vector<unsigned> buckets_; // 0 when empty, index + 1 otherwise
+  };
+}
@@ -103,6 +103,10 @@ namespace spot
   /// The implemented algorithm is the same as the one of
   /// spot::explicit_magic_search.
   ///
+  /// If option \c "hash_seed" is set in \a o, the hash values of
+  /// the states are scrambled with it, so that searches using
+  /// different seeds confuse different states.
+  ///
   /// \sa spot::explicit_magic_search
   ///
   SPOT_API emptiness_check_ptr
@@ -526,9 +526,11 @@ namespace spot
 
   // Declared in tl/hierarchy.cc, but defined here because it relies on
   // other internal functions from this file.
-  SPOT_LOCAL bool is_wdba_realizable(formula f, twa_graph_ptr aut = nullptr);
+  SPOT_LOCAL bool is_wdba_realizable(formula f, twa_graph_ptr aut = nullptr,
+                                     const_twa_graph_ptr aut_neg = nullptr);
 
-  bool is_wdba_realizable(formula f, twa_graph_ptr aut)
+  bool is_wdba_realizable(formula f, twa_graph_ptr aut,
+                          const_twa_graph_ptr given_neg)
   {
     if (f.is_syntactic_obligation())
       return true;
@@ -557,8 +559,9 @@ namespace spot
       }
     else
       {
-        aut_neg = ltl_to_tgba_fm(formula::Not(f), aut->get_dict());
-        aut_neg = scc_filter(aut_neg, true);
+        aut_neg = scc_filter(given_neg ? given_neg :
+                             ltl_to_tgba_fm(formula::Not(f), aut->get_dict()),
+                             true);
       }
 
     if (is_terminal_automaton(aut_neg))
@@ -0,0 +1,102 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/twaalgos/multiprop.hh>
+#include <spot/kripke/kripkegraph.hh>
+#include <spot/twa/twaproduct.hh>
+#include <string>
+
+namespace spot
+{
+  namespace
+  {
+    // Copy the reachable part of MODEL into a kripke_graph, numbering
+    // the states in the order in which they are discovered.
+    static kripke_graph_ptr
+    explore(const const_kripke_ptr& model, bool names)
+    {
+      auto res = make_kripke_graph(model->get_dict());
+      res->copy_ap_of(model);
+      std::vector<std::string>* state_names = nullptr;
+      if (names)
+        {
+          state_names = new std::vector<std::string>;
+          res->set_named_prop("state-names", state_names);
+        }
+
+      state_map<unsigned> seen;
+      std::vector<const state*> todo;
+      auto number = [&](const state* s)
+        {
+          auto p = seen.emplace(s, todo.size());
+          if (p.second)
+            {
+              res->new_state(model->state_condition(s));
+              if (state_names)
+                state_names->push_back(model->format_state(s));
+              todo.push_back(s);
+            }
+          else
+            {
+              s->destroy();
+            }
+          return p.first->second;
+        };
+
+      number(model->get_init_state());
+      for (unsigned src = 0; src < todo.size(); ++src)
+        for (auto i: model->succ(todo[src]))
+          res->new_edge(src, number(i->dst()));
+      for (auto s: todo)
+        s->destroy();
+      res->set_init_state(0);
+      return res;
+    }
+  }
+
+  std::vector<property_result>
+  multi_property_check(const const_kripke_ptr& model,
+                       const std::vector<const_twa_ptr>& props,
+                       emptiness_check_instantiator_ptr inst,
+                       bool want_runs)
+  {
+    if (!inst)
+      {
+        const char* err;
+        inst = make_emptiness_check_instantiator("Cou99", &err);
+      }
+    const_kripke_ptr k = std::dynamic_pointer_cast<const kripke_graph>(model);
+    if (!k)
+      k = explore(model, want_runs);
+
+    std::vector<property_result> res(props.size());
+    for (unsigned i = 0; i < props.size(); ++i)
+      {
+        auto ec = inst->instantiate(otf_product(k, props[i]));
+        auto r = ec->check();
+        if (!r)
+          continue;
+        res[i].non_empty = true;
+        if (want_runs)
+          res[i].run = r->accepting_run();
+      }
+    return res;
+  }
+}
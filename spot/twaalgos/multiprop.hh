@@ -0,0 +1,66 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/kripke/kripke.hh>
+#include <spot/twaalgos/emptiness.hh>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup emptiness_check
+  /// \brief The outcome of multi_property_check() for one automaton.
+  struct SPOT_API property_result
+  {
+    /// Whether the product with the automaton has an accepting run.
+    bool non_empty = false;
+    /// \brief An accepting run of that product.
+    ///
+    /// This is only computed if requested, and may be null if the
+    /// emptiness check cannot compute runs.
+    twa_run_ptr run = nullptr;
+  };
+
+  /// \ingroup emptiness_check
+  /// \brief Check several automata against one Kripke structure.
+  ///
+  /// The reachable part of \a model is explored once and copied into
+  /// a kripke_graph, unless \a model is already a kripke_graph.  Each
+  /// automaton of \a props is then checked against this copy with
+  /// the emptiness check created by \a inst (Cou99 if \a inst is
+  /// null), on the explicit product returned by otf_product().  So
+  /// the successors of each state of \a model are computed only
+  /// once, however many automata are checked.
+  ///
+  /// \a model should observe all the atomic propositions used by \a
+  /// props, and all of them should share the same bdd_dict.  If \a
+  /// want_runs is set, the accepting run of each non-empty product is
+  /// computed, and the states of the copy are named after those of
+  /// \a model.
+  ///
+  /// The verdicts are returned in the order of \a props.  A product
+  /// reported empty by an unsafe emptiness check (see
+  /// emptiness_check::safe()) might still have an accepting run.
+  SPOT_API std::vector<property_result>
+  multi_property_check(const const_kripke_ptr& model,
+                       const std::vector<const_twa_ptr>& props,
+                       emptiness_check_instantiator_ptr inst = nullptr,
+                       bool want_runs = false);
+}
@@ -44,11 +44,18 @@ namespace spot
   struct stack_item
   {
     stack_item(const state* n, twa_succ_iterator* i, bdd l, acc_cond::mark_t a)
-      noexcept : s(n), it(i), label(l), acc(a) {};
+      noexcept : s(n), it(i), begin(0), pos(0), label(l), acc(a) {};
+    stack_item(const state* n, unsigned b, bdd l, acc_cond::mark_t a)
+      noexcept : s(n), it(nullptr), begin(b), pos(b), label(l), acc(a) {};
     /// The visited state.
     const state* s;
     /// Design the next successor of \a s which has to be visited.
     twa_succ_iterator* it;
+    /// When the successors of \a s are stored in a succ_buffer
+    /// instead (and \a it is nullptr), the position of the first one,
+    /// and of the next one to visit.
+    unsigned begin;
+    unsigned pos;
     /// The label of the transition traversed to reach \a s
     /// (false for the first one).
     bdd label;
@@ -59,6 +66,55 @@ namespace spot
 
   typedef std::list<stack_item> stack_type;
 
+  /// \brief The successors of the states of a depth-first search
+  /// stack.
+  ///
+  /// The successors of a state are all retrieved with
+  /// twa_succ_iterator::fill() when it is pushed, and stored after
+  /// the successors of the states below it.  Only the item on top of
+  /// the stack can therefore be used with done() and take().
+  class succ_buffer final
+  {
+  public:
+    /// Store the successors of \a s, and return the position of the
+    /// first one.
+    unsigned push(const const_twa_ptr& a, const state* s)
+    {
+      unsigned begin = buf_.size();
+      twa_succ_iterator* it = a->succ_iter(s);
+      it->fill(buf_);
+      a->release_iter(it);
+      return begin;
+    }
+
+    /// Whether all the successors of \a f have been visited.
+    bool done(const stack_item& f) const
+    {
+      return f.pos == buf_.size();
+    }
+
+    /// \brief Visit the next successor of \a f.
+    ///
+    /// The caller becomes responsible for the destination state.
+    /// The returned reference is invalidated by push().
+    const twa_succ& take(stack_item& f) const
+    {
+      return buf_[f.pos++];
+    }
+
+    /// Forget the successors of \a f, destroying those that have not
+    /// been visited.
+    void pop(const stack_item& f)
+    {
+      for (unsigned i = f.pos; i < buf_.size(); ++i)
+        buf_[i].dst->destroy();
+      buf_.resize(f.begin);
+    }
+
+  private:
+    std::vector<twa_succ> buf_;
+  };
+
   namespace
   {
     // The acss_statistics is available only when the heap has a
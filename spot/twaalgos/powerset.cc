@@ -37,6 +37,8 @@
 #include <spot/twaalgos/remfin.hh>
 #include <spot/misc/bitvect.hh>
 #include <spot/misc/bddlt.hh>
+#include <spot/twa/letters.hh>
+#include <memory>
 
 namespace spot
 {
@@ -87,26 +89,41 @@ namespace spot
     unsigned ns = aut->num_states();
     unsigned nap = aut->ap().size();
 
-    if ((-1UL / ns) >> nap == 0)
-      throw std::runtime_error("too many atomic propositions (or states)");
-
-    // Build a correspondence between conjunctions of APs and unsigned
-    // indexes.
+    // Build a correspondence between sets of letters and unsigned
+    // indexes.  With up to letter_sets::max_aps atomic propositions,
+    // these sets are the letters themselves, and the letters of each
+    // label are read from a bit-set.  The letters of letter_sets are
+    // numbered in the same order as the cubes returned by
+    // bdd_satoneset().  With more atomic propositions, enumerating
+    // all letters is not an option, so we use the classes of the
+    // alphabet partition induced by the labels of the automaton.
     std::vector<bdd> num2bdd;
-    num2bdd.reserve(1UL << nap);
-    std::map<bdd, unsigned, bdd_less_than> bdd2num;
-    bdd all = bddtrue;
     bdd allap = aut->ap_vars();
-    while (all != bddfalse)
+    std::unique_ptr<letter_sets> ls;
+    const alphabet_partition* part = nullptr;
+    if (nap <= letter_sets::max_aps)
       {
-        bdd one = bdd_satoneset(all, allap, bddfalse);
-        all -= one;
-        bdd2num.emplace(one, num2bdd.size());
-        num2bdd.emplace_back(one);
+        if ((-1UL / ns) >> nap == 0)
+          throw std::runtime_error("too many atomic propositions "
+                                   "(or states)");
+        ls = std::make_unique<letter_sets>(allap);
+        num2bdd.reserve(1UL << nap);
+        for (unsigned i = 0, n = ls->num_letters(); i < n; ++i)
+          num2bdd.emplace_back(ls->letter(i));
+      }
+    else
+      {
+        part = &alphabet_partition::of(aut);
+        unsigned n = part->num_classes();
+        if ((-1UL / ns) < n)
+          throw std::runtime_error("too many atomic propositions "
+                                   "(or states)");
+        num2bdd.reserve(n);
+        for (unsigned i = 0; i < n; ++i)
+          num2bdd.emplace_back(part->class_bdd(i));
       }
 
     size_t nc = num2bdd.size();        // number of conditions
-    assert(nc == (1UL << nap));
 
     // Conceptually, we represent the automaton as an array 'bv' of
     // ns*nc bit vectors of size 'ns'.  Each original state is
@@ -183,14 +200,17 @@ namespace spot
           bv->at(base + i).clear_all();
       for (auto& t: aut->out(src))
         {
-          bdd all = t.cond;
-          while (all != bddfalse)
+          if (ls)
             {
-              bdd one = bdd_satoneset(all, allap, bddfalse);
-              all -= one;
-              unsigned num = bdd2num[one];
-              bv->at(base + num).set(t.dst);
+              letter_sets::for_each_letter(ls->as_set(t.cond),
+                                           [&](unsigned num)
+                                           {
+                                             bv->at(base + num).set(t.dst);
+                                           });
+              continue;
             }
+          for (unsigned num: part->classes_of(aut->edge_number(t)))
+            bv->at(base + num).set(t.dst);
         }
 
       assert(idx == lru.begin()->first);
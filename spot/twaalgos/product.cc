@@ -20,6 +20,7 @@
 #include "config.h"
 #include <spot/twaalgos/product.hh>
 #include <spot/twa/twagraph.hh>
+#include <spot/twa/letters.hh>
 #include <spot/twaalgos/complete.hh>
 #include <spot/twaalgos/sccinfo.hh>
 #include <spot/twaalgos/isdet.hh>
@@ -77,6 +78,41 @@ namespace spot
         // Do not bother doing any work if the resulting acceptance is
         // false.
         return;
+
+      // With few atomic propositions, represent labels as sets of
+      // letters, so that conjunctions and emptiness checks do not
+      // have to go through BuDDy.
+      if (letter_masks::usable(res))
+        {
+          letter_masks lm(res->ap_vars());
+          auto lmasks = lm.edge_masks(left);
+          auto rmasks = lm.edge_masks(right);
+          while (!todo.empty())
+            {
+              if (aborter && aborter->too_large(res))
+                {
+                  res = nullptr;
+                  return;
+                }
+              auto top = todo.front();
+              todo.pop_front();
+              for (auto& l: left->out(top.first.first))
+                {
+                  auto lmask = lmasks[left->edge_number(l)];
+                  for (auto& r: right->out(top.first.second))
+                    {
+                      auto m = lmask & rmasks[right->edge_number(r)];
+                      if (!m)
+                        continue;
+                      auto dst = new_state(l.dst, r.dst);
+                      res->new_edge(top.second, dst, lm.as_bdd(m),
+                                    merge_acc(l.acc, r.acc));
+                    }
+                }
+            }
+          return;
+        }
+
       while (!todo.empty())
         {
           if (aborter && aborter->too_large(res))
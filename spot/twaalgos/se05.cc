@@ -33,6 +33,7 @@
 #include <cassert>
 #include <list>
 #include <spot/misc/hash.hh>
+#include <spot/misc/hashfunc.hh>
 #include <spot/twa/twa.hh>
 #include <spot/twaalgos/emptiness.hh>
 #include <spot/twaalgos/emptiness_stats.hh>
@@ -58,7 +59,7 @@ namespace spot
       se05_search(const const_twa_ptr a, size_t size,
                   option_map o = option_map())
         : emptiness_check(a, o),
-          h(size)
+          h(size, o.get("hash_seed"))
       {
         if (!(a->prop_weak().is_true()
               || a->num_sets() == 0
@@ -69,18 +70,18 @@ namespace spot
       virtual ~se05_search()
       {
         // Release all iterators on the stacks.
-        while (!st_blue.empty())
-          {
-            h.pop_notify(st_blue.front().s);
-            a_->release_iter(st_blue.front().it);
-            st_blue.pop_front();
-          }
         while (!st_red.empty())
           {
             h.pop_notify(st_red.front().s);
-            a_->release_iter(st_red.front().it);
+            succs.pop(st_red.front());
             st_red.pop_front();
           }
+        while (!st_blue.empty())
+          {
+            h.pop_notify(st_blue.front().s);
+            succs.pop(st_blue.front());
+            st_blue.pop_front();
+          }
       }
 
       /// \brief Perform a Magic Search.
@@ -157,18 +158,21 @@ namespace spot
                 const bdd& label, acc_cond::mark_t acc)
       {
         inc_depth();
-        twa_succ_iterator* i = a_->succ_iter(s);
-        i->first();
-        st.emplace_front(s, i, label, acc);
+        st.emplace_front(s, succs.push(a_, s), label, acc);
       }
 
       void pop(stack_type& st)
       {
         dec_depth();
-        a_->release_iter(st.front().it);
+        succs.pop(st.front());
         st.pop_front();
       }
 
+      /// \brief Successors of the states of st_blue and st_red.
+      ///
+      /// The red stack is always above the blue one.
+      succ_buffer succs;
+
       /// \brief Stack of the blue dfs.
       stack_type st_blue;
 
@@ -185,18 +189,21 @@ namespace spot
           {
             stack_item& f = st_blue.front();
             trace << "DFS_BLUE treats: " << a_->format_state(f.s) << std::endl;
-            if (!f.it->done())
+            if (!succs.done(f))
               {
-                const state *s_prime = f.it->dst();
+                const twa_succ& succ = succs.take(f);
+                const state *s_prime = succ.dst;
                 trace << "  Visit the successor: "
                       << a_->format_state(s_prime) << std::endl;
-                bdd label = f.it->cond();
-                auto acc = f.it->acc();
+                bdd label = succ.cond;
+                auto acc = succ.acc;
                 // Go down the edge (f.s, <label, acc>, s_prime)
-                f.it->next();
                 inc_transitions();
                 if (SPOT_UNLIKELY(label == bddfalse))
-                  continue;
+                  {
+                    s_prime->destroy();
+                    continue;
+                  }
                 typename heap::color_ref c = h.get_color_ref(s_prime);
                 if (c.is_white())
                   {
@@ -278,18 +285,21 @@ namespace spot
           {
             stack_item& f = st_red.front();
             trace << "DFS_RED treats: " << a_->format_state(f.s) << std::endl;
-            if (!f.it->done())
+            if (!succs.done(f))
               {
-                const state *s_prime = f.it->dst();
+                const twa_succ& succ = succs.take(f);
+                const state *s_prime = succ.dst;
                 trace << "  Visit the successor: "
                       << a_->format_state(s_prime) << std::endl;
-                bdd label = f.it->cond();
-                auto acc = f.it->acc();
+                bdd label = succ.cond;
+                auto acc = succ.acc;
                 // Go down the edge (f.s, <label, acc>, s_prime)
-                f.it->next();
                 inc_transitions();
                 if (SPOT_UNLIKELY(label == bddfalse))
-                  continue;
+                  {
+                    s_prime->destroy();
+                    continue;
+                  }
                 typename heap::color_ref c = h.get_color_ref(s_prime);
                 if (c.is_white())
                   {
@@ -496,7 +506,7 @@ namespace spot
         color *pc; // point to the color of a state stored in main hash table
       };
 
-      explicit_se05_search_heap(size_t)
+      explicit_se05_search_heap(size_t, unsigned)
         {
         }
 
@@ -625,7 +635,8 @@ namespace spot
         unsigned char o;
       };
 
-      bsh_se05_search_heap(size_t s) : size_(s)
+      bsh_se05_search_heap(size_t s, unsigned seed)
+        : size_(s), seed_(seed)
         {
           h = new unsigned char[size_];
           memset(h, WHITE, size_);
@@ -638,7 +649,7 @@ namespace spot
 
       color_ref get_color_ref(const state*& s)
         {
-          size_t ha = s->hash();
+          size_t ha = hash(s);
           hcyan_type::iterator ic = hc.find(s);
           if (ic != hc.end())
             return color_ref(&hc, *ic, &h[ha%size_], ha%4);
@@ -667,14 +678,24 @@ namespace spot
           hcyan_type::const_iterator ic = hc.find(s);
           if (ic != hc.end())
             return true;
-          size_t ha = s->hash();
+          size_t ha = hash(s);
           return color((h[ha%size_] >> ((ha%4)*2)) & 3U) != WHITE;
         }
 
       enum { Has_Size = 0 };
 
     private:
+      // With a non-zero seed (option hash_seed), the hash values of
+      // states are scrambled so that different seeds confuse
+      // different states.  A null seed keeps the original values.
+      size_t hash(const state* s) const
+        {
+          size_t ha = s->hash();
+          return seed_ ? wang32_hash(ha ^ seed_) : ha;
+        }
+
       size_t size_;
+      size_t seed_;
       unsigned char* h;
       hcyan_type hc;
     };
@@ -22,6 +22,8 @@
 #include <spot/misc/minato.hh>
 #include <spot/twaalgos/totgba.hh>
 #include <spot/misc/bddlt.hh>
+#include <spot/twa/letters.hh>
+#include <memory>
 
 namespace spot
 {
@@ -157,6 +159,12 @@ namespace spot
     internal::univ_dest_mapper<twa_graph::graph_t> uniq(out->get_graph());
 
     bdd all = aut->ap_vars();
+    // With few atomic propositions, enumerate the letters of each
+    // label from its set of letters instead of calling
+    // bdd_satoneset().  The letters are visited in the same order.
+    std::unique_ptr<letter_sets> ls;
+    if (letter_sets::usable(aut))
+      ls = std::make_unique<letter_sets>(all);
     for (auto& e: aut->edges())
       {
         bdd cond = e.cond;
@@ -168,6 +176,14 @@ namespace spot
             auto d = aut->univ_dests(dst);
             dst = uniq.new_univ_dests(d.begin(), d.end());
           }
+        if (ls)
+          {
+            letter_sets::for_each_letter(ls->as_set(cond), [&](unsigned i)
+              {
+                out->new_edge(e.src, dst, ls->letter(i), e.acc);
+              });
+            continue;
+          }
         while (cond != bddfalse)
           {
             bdd cube = bdd_satoneset(cond, all, bddfalse);
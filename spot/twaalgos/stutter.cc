@@ -101,8 +101,10 @@ namespace spot
     {
     public:
       twasl_succ_iterator(twa_succ_iterator* it, const state_tgbasl* state,
-                           bdd_dict_ptr d, bdd atomic_propositions)
-        : it_(it), state_(state), aps_(atomic_propositions), d_(d)
+                           bdd_dict_ptr d, bdd atomic_propositions,
+                           acc_cond::mark_t toadd)
+        : it_(it), state_(state), aps_(atomic_propositions), d_(d),
+          toadd_(toadd)
       {
       }
 
@@ -180,7 +182,7 @@ namespace spot
       {
         if (loop_)
           return {};
-        return it_->acc();
+        return it_->acc() | toadd_;
       }
 
     private:
@@ -200,6 +202,7 @@ namespace spot
       bdd one_;
       bdd aps_;
       bdd_dict_ptr d_;
+      acc_cond::mark_t toadd_;
       bool loop_;
       bool need_loop_;
       bool done_;
@@ -214,6 +217,14 @@ namespace spot
       {
         copy_ap_of(a);
         copy_acceptance_of(a_);
+        // As in sl(), the added self-loops should not be accepting.
+        if (acc().accepting({}))
+          {
+            unsigned ns = num_sets();
+            set_acceptance(ns + 1, get_acceptance()
+                           & acc_cond::acc_code::inf({ns}));
+            toadd_ = {ns};
+          }
       }
 
       virtual const state* get_init_state() const override
@@ -225,7 +236,7 @@ namespace spot
       {
         const state_tgbasl* s = down_cast<const state_tgbasl*>(state);
         return new twasl_succ_iterator(a_->succ_iter(s->real_state()), s,
-                                       a_->get_dict(), ap_vars());
+                                       a_->get_dict(), ap_vars(), toadd_);
       }
 
       virtual std::string format_state(const state* state) const override
@@ -238,6 +249,7 @@ namespace spot
 
     private:
       const_twa_ptr a_;
+      acc_cond::mark_t toadd_ = {};
     };
 
     typedef std::shared_ptr<tgbasl> tgbasl_ptr;
@@ -666,7 +678,8 @@ namespace spot
   }
 
   bool
-  is_stutter_invariant(formula f, twa_graph_ptr aut_f)
+  is_stutter_invariant(formula f, twa_graph_ptr aut_f,
+                       const_twa_graph_ptr aut_nf)
   {
     if (f.is_ltl_formula() && f.is_syntactic_stutter_invariant())
       return true;
@@ -703,7 +716,9 @@ namespace spot
         aut_f = trans.run(f);
         own_f = true;
       }
-    return is_stutter_invariant_aux(aut_f, own_f, trans.run(formula::Not(f)));
+    if (!aut_nf)
+      aut_nf = trans.run(formula::Not(f));
+    return is_stutter_invariant_aux(aut_f, own_f, aut_nf);
   }
 
   trival
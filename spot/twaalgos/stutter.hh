@@ -81,15 +81,15 @@ namespace spot
   ///
   /// If you already have an automaton for f, passing it at a second
   /// argument will save some time.  If you also have an automaton for
-  /// the negation of f, it is better to use the overload of
-  /// is_stutter_invariant() that takes two automata.
+  /// the negation of f, pass it as a third argument.
   ///
   /// The prop_stutter_invariant() property of \a aut_f is set as a
   /// side-effect.
   ///
   /// For more details about this function, see \cite michaud.15.spin .
   SPOT_API bool
-  is_stutter_invariant(formula f, twa_graph_ptr aut_f = nullptr);
+  is_stutter_invariant(formula f, twa_graph_ptr aut_f = nullptr,
+                       const_twa_graph_ptr aut_nf = nullptr);
 
   /// \ingroup stutter_inv
   /// \brief Check if an automaton has the stutter invariance
@@ -0,0 +1,224 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <spot/twaalgos/swarm.hh>
+#include <spot/twa/twa.hh>
+#include <spot/priv/forkworkers.hh>
+#include <stdexcept>
+
+namespace spot
+{
+  namespace
+  {
+    static uint64_t
+    splitmix64(uint64_t& x)
+    {
+      uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    class shuffled_succ_iterator final: public twa_succ_iterator
+    {
+    public:
+      shuffled_succ_iterator(twa_succ_iterator* it, uint64_t seed)
+      {
+        it->fill(succs_);
+        // Fisher-Yates shuffle.
+        for (unsigned i = succs_.size(); i > 1; --i)
+          std::swap(succs_[i - 1], succs_[splitmix64(seed) % i]);
+      }
+
+      virtual
+      ~shuffled_succ_iterator()
+      {
+        for (auto& s: succs_)
+          s.dst->destroy();
+      }
+
+      virtual bool
+      first() override
+      {
+        pos_ = 0;
+        return !succs_.empty();
+      }
+
+      virtual bool
+      next() override
+      {
+        return ++pos_ < succs_.size();
+      }
+
+      virtual bool
+      done() const override
+      {
+        return pos_ >= succs_.size();
+      }
+
+      virtual const state*
+      dst() const override
+      {
+        return succs_[pos_].dst->clone();
+      }
+
+      virtual bdd
+      cond() const override
+      {
+        return succs_[pos_].cond;
+      }
+
+      virtual acc_cond::mark_t
+      acc() const override
+      {
+        return succs_[pos_].acc;
+      }
+
+      virtual unsigned
+      fill(std::vector<twa_succ>& buf) override
+      {
+        for (auto& s: succs_)
+          buf.push_back({s.dst->clone(), s.cond, s.acc});
+        pos_ = succs_.size();
+        return succs_.size();
+      }
+
+    private:
+      std::vector<twa_succ> succs_;
+      unsigned pos_ = 0;
+    };
+
+    class shuffled_twa final: public twa
+    {
+    public:
+      shuffled_twa(const const_twa_ptr& a, unsigned seed)
+        : twa(a->get_dict()), a_(a), seed_(seed)
+      {
+        copy_ap_of(a);
+        copy_acceptance_of(a);
+      }
+
+      virtual const state* get_init_state() const override
+      {
+        return a_->get_init_state();
+      }
+
+      virtual twa_succ_iterator* succ_iter(const state* s) const override
+      {
+        twa_succ_iterator* it = a_->succ_iter(s);
+        uint64_t seed = (static_cast<uint64_t>(seed_) << 32) ^ s->hash();
+        auto res = new shuffled_succ_iterator(it, seed);
+        a_->release_iter(it);
+        return res;
+      }
+
+      virtual std::string format_state(const state* s) const override
+      {
+        return a_->format_state(s);
+      }
+
+      virtual state* project_state(const state* s,
+                                   const const_twa_ptr& t) const override
+      {
+        if (t.get() == this)
+          return s->clone();
+        return a_->project_state(s, t);
+      }
+
+    private:
+      const_twa_ptr a_;
+      unsigned seed_;
+    };
+
+    // What a worker reports to the parent process.
+    enum worker_status { found, empty, maybe_empty, failed };
+  }
+
+  const_twa_ptr
+  shuffle_successors(const const_twa_ptr& aut, unsigned seed)
+  {
+    return std::make_shared<shuffled_twa>(aut, seed);
+  }
+
+  emptiness_check_ptr
+  swarm_instantiate(const const_twa_ptr& aut,
+                    const std::vector<emptiness_check_instantiator_ptr>&
+                    algos, unsigned i)
+  {
+    if (algos.empty())
+      throw std::runtime_error("swarm_instantiate: no algorithm given");
+    const auto& inst = algos[i % algos.size()];
+    if (i < algos.size())
+      return inst->instantiate(aut);
+    option_map& o = inst->options();
+    int old = o.set("hash_seed", i);
+    emptiness_check_ptr ec;
+    try
+      {
+        ec = inst->instantiate(shuffle_successors(aut, i));
+      }
+    catch (...)
+      {
+        o.set("hash_seed", old);
+        throw;
+      }
+    o.set("hash_seed", old);
+    return ec;
+  }
+
+  swarm_result
+  swarm_emptiness_check(const const_twa_ptr& aut,
+                        const std::vector<emptiness_check_instantiator_ptr>&
+                        algos, unsigned workers)
+  {
+    if (algos.empty())
+      throw std::runtime_error("swarm_emptiness_check: "
+                               "no algorithm given");
+    if (workers == 0)
+      throw std::runtime_error("swarm_emptiness_check: no worker");
+
+    swarm_result res;
+    unsigned maybe = 0;
+    fork_workers("swarm_emptiness_check", workers, failed,
+                 [&](unsigned i)
+                 {
+                   auto ec = swarm_instantiate(aut, algos, i);
+                   if (ec->check())
+                     return found;
+                   return ec->safe() ? empty : maybe_empty;
+                 },
+                 // Stop at the first report that decides the result.
+                 [&](unsigned i, int status)
+                 {
+                   if (status == found || status == empty)
+                     {
+                       res.worker = i;
+                       res.non_empty = status == found;
+                       return true;
+                     }
+                   if (status == maybe_empty)
+                     ++maybe;
+                   return false;
+                 });
+    if (res.worker < 0 && maybe == 0)
+      throw std::runtime_error("swarm_emptiness_check: all workers failed");
+    return res;
+  }
+}
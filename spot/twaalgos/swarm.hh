@@ -0,0 +1,94 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <spot/twa/fwd.hh>
+#include <spot/twaalgos/emptiness.hh>
+#include <vector>
+
+namespace spot
+{
+  /// \ingroup emptiness_check
+  /// \brief Present the successors of each state in a shuffled order.
+  ///
+  /// The returned automaton has the same states and transitions as
+  /// \a aut, but the successors of each state are enumerated in a
+  /// pseudo-random order that only depends on \a seed and on the
+  /// hash() of the state.  Running a depth-first emptiness check on
+  /// automata shuffled with different seeds explores different parts
+  /// of the state space first.
+  ///
+  /// All the successors of a state are computed (and cloned) when
+  /// its iterator is created, so this costs time and memory.
+  SPOT_API const_twa_ptr
+  shuffle_successors(const const_twa_ptr& aut, unsigned seed);
+
+  /// \ingroup emptiness_check
+  /// \brief The outcome of swarm_emptiness_check().
+  struct SPOT_API swarm_result
+  {
+    /// \brief The worker that decided the result.
+    ///
+    /// This is -1 if no worker found an accepting run and no safe
+    /// worker completed its check.
+    int worker = -1;
+    /// Whether that worker found an accepting run.
+    bool non_empty = false;
+  };
+
+  /// \ingroup emptiness_check
+  /// \brief Create the emptiness check run by a worker of
+  /// swarm_emptiness_check().
+  ///
+  /// Worker \a i uses the algorithm `algos[i % algos.size()]`.  The
+  /// first `algos.size()` workers run on \a aut, while the following
+  /// ones run on `shuffle_successors(aut, i)`, and have their option
+  /// `hash_seed` set to \a i, so that the algorithms using hash
+  /// compaction or bit-state hashing confuse different states.
+  ///
+  /// This can be used to replay the search of the worker that won
+  /// swarm_emptiness_check() in the current process, and obtain its
+  /// accepting run.
+  SPOT_API emptiness_check_ptr
+  swarm_instantiate(const const_twa_ptr& aut,
+                    const std::vector<emptiness_check_instantiator_ptr>&
+                    algos, unsigned i);
+
+  /// \ingroup emptiness_check
+  /// \brief Run diversified emptiness checks in parallel.
+  ///
+  /// This starts \a workers child processes, and worker \a i runs the
+  /// emptiness check returned by `swarm_instantiate(aut, algos, i)`.
+  /// Processes are used instead of threads because BDDs and formulas
+  /// cannot be shared between threads.  As soon as a worker finds an
+  /// accepting run, or a safe worker (see emptiness_check::safe())
+  /// reports that the language is empty, all the other workers are
+  /// killed.
+  ///
+  /// The accepting run cannot be returned by the child process, so
+  /// use swarm_instantiate() to replay the search of the winning
+  /// worker if needed.  An std::runtime_error is thrown if \a algos
+  /// or \a workers is empty, if a process cannot be started, or if
+  /// all workers failed without deciding the result.
+  SPOT_API swarm_result
+  swarm_emptiness_check(const const_twa_ptr& aut,
+                        const std::vector<emptiness_check_instantiator_ptr>&
+                        algos, unsigned workers);
+}
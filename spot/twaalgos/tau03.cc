@@ -40,6 +40,7 @@
 #include <spot/twaalgos/emptiness.hh>
 #include <spot/twaalgos/emptiness_stats.hh>
 #include <spot/twaalgos/tau03.hh>
+#include <spot/twaalgos/lossyset.hh>
 #include <spot/twaalgos/ndfs_result.hxx>
 
 namespace spot
@@ -55,9 +56,9 @@ namespace spot
     {
     public:
       /// \brief Initialize the search algorithm on the automaton \a a
-      tau03_search(const const_twa_ptr a, size_t size, option_map o)
+      tau03_search(const const_twa_ptr a, option_map o)
         : emptiness_check(a, o),
-          h(size)
+          h(o)
       {
         if (!(a->num_sets() > 0 && a->acc().is_generalized_buchi()))
           throw std::runtime_error
@@ -96,7 +97,9 @@ namespace spot
         push(st_blue, s0, bddfalse, {});
         auto t = std::static_pointer_cast<tau03_search>
           (this->emptiness_check::shared_from_this());
-        if (dfs_blue())
+        bool found = dfs_blue();
+        set_coverage(h.coverage());
+        if (found)
           return std::make_shared<ndfs_result<tau03_search<heap>, heap>>(t);
         return nullptr;
       }
@@ -106,9 +109,16 @@ namespace spot
         os << states() << " distinct nodes visited" << std::endl;
         os << transitions() << " transitions explored" << std::endl;
         os << max_depth() << " nodes for the maximal stack depth" << std::endl;
+        if (coverage() < 1)
+          os << coverage() * 100 << "% estimated coverage" << std::endl;
         return os;
       }
 
+      virtual bool safe() const override
+      {
+        return heap::Safe;
+      }
+
       const heap& get_heap() const
         {
           return h;
@@ -288,6 +298,8 @@ namespace spot
     class explicit_tau03_search_heap final
     {
     public:
+      enum { Safe = 1 };
+
       class color_ref final
       {
       public:
@@ -322,7 +334,7 @@ namespace spot
         acc_cond::mark_t* acc;
       };
 
-      explicit_tau03_search_heap(size_t)
+      explicit_tau03_search_heap(const option_map&)
         {
         }
 
@@ -373,18 +385,86 @@ namespace spot
         {
           return h.size();
         }
+
+      double coverage() const
+        {
+          return 1.0;
+        }
     private:
       state_map<std::pair<color, acc_cond::mark_t>> h;
     };
 
+    // Store only the fingerprints of the states, as a lossy_state_set
+    // configured for hash compaction.  Fingerprints are numbered, and
+    // the color and acceptance sets of each state are stored in a
+    // vector indexed by these numbers.
+    class hc_tau03_search_heap final
+    {
+    public:
+      enum { Safe = 0 };
+
+      typedef explicit_tau03_search_heap::color_ref color_ref;
+
+      hc_tau03_search_heap(const option_map& o)
+        : fp(lossy_state_set::from_options(o))
+        {
+          SPOT_ASSERT(fp && fp->type() == lossy_state_set::hash_compaction);
+        }
+
+      color_ref get_color_ref(const state*& s)
+        {
+          unsigned i = fp->find(s);
+          if (i == lossy_state_set::npos)
+            return color_ref(nullptr, nullptr);
+          return color_ref(&h[i].first, &h[i].second);
+        }
+
+      void add_new_state(const state* s, color c)
+        {
+          SPOT_ASSERT(fp->find(s) == lossy_state_set::npos);
+          fp->insert(s);
+          h.emplace_back(c, acc_cond::mark_t({}));
+        }
+
+      void pop_notify(const state* s) const
+        {
+          s->destroy();
+        }
+
+      bool has_been_visited(const state* s) const
+        {
+          return fp->find(s) != lossy_state_set::npos;
+        }
+
+      enum { Has_Size = 1 };
+      int size() const
+        {
+          return h.size();
+        }
+
+      double coverage() const
+        {
+          return fp->coverage();
+        }
+    private:
+      std::unique_ptr<lossy_state_set> fp;
+      std::vector<std::pair<color, acc_cond::mark_t>> h;
+    };
+
   } // anonymous
 
   emptiness_check_ptr
   explicit_tau03_search(const const_twa_ptr& a, option_map o)
   {
+    if (o.get("bsh"))
+      throw std::runtime_error("tau03 does not support bit-state hashing, "
+                               "use hash compaction (hc) instead");
+    if (o.get("hc"))
+      return
+        SPOT_make_shared_enabled__(tau03_search<hc_tau03_search_heap>, a, o);
     return
       SPOT_make_shared_enabled__(tau03_search<explicit_tau03_search_heap>,
-                                 a, 0, o);
+                                 a, o);
   }
 
 }
@@ -76,6 +76,12 @@ namespace spot
       \endverbatim */
   ///
   /// This algorithm is the one presented in \cite tauriainen.03.tr .
+  ///
+  /// If option \c "hc" is set in \a o, only fingerprints of \c "hc"
+  /// bits are stored instead of the states (see
+  /// lossy_state_set::from_options(), which also uses \c "hash_seed").
+  /// Bit-state hashing is not supported, as the algorithm needs to
+  /// remember acceptance sets for each state.
   SPOT_API emptiness_check_ptr
   explicit_tau03_search(const const_twa_ptr& a, option_map o = option_map());
 
@@ -657,7 +657,7 @@ get_inputs_states(const twa_graph_ptr& aut)
 {
     auto used = aut->acc().get_acceptance().used_sets();
     std::vector<std::set<acc_cond::mark_t>> inputs(aut->num_states());
-    for (auto e : aut->edges())
+    for (auto& e : aut->edges())
     {
         auto elements = e.acc & used;
         if (elements.has_many())
@@ -673,7 +673,7 @@ get_inputs_iar(const twa_graph_ptr& aut, algorithm algo,
                const std::vector<acc_cond::rs_pair>& pairs)
 {
     std::vector<std::set<std::vector<unsigned>>> inputs(aut->num_states());
-    for (auto e : aut->edges())
+    for (auto& e : aut->edges())
     {
         auto acc = e.acc;
         std::vector<unsigned> new_vect;
@@ -848,11 +848,12 @@ explicit car_generator(const const_twa_graph_ptr &a, to_parity_options options)
 // During the creation of the states, we had to choose between a set of
 // compatible states. But it is possible to create another compatible state
 // after. This function checks if a compatible state was created after and
-// use it.
+// use it.  partial_history[i] is related to edge number first_edge + i.
 void
 change_transitions_destination(twa_graph_ptr& aut,
 const std::vector<unsigned>& states,
-std::map<unsigned, std::vector<unsigned>>& partial_history,
+const std::vector<std::vector<unsigned>>& partial_history,
+unsigned first_edge,
 state_2_car_scc& state_2_car)
 {
     for (auto s : states)
@@ -865,7 +866,8 @@ state_2_car_scc& state_2_car)
             if (src == dst)
                 continue;
             unsigned dst_scc = num2car[dst].state_scc;
-            auto cant_change = partial_history[aut->edge_number(edge)];
+            const auto& cant_change =
+                partial_history[aut->edge_number(edge) - first_edge];
             edge.dst = state_2_car.get_sub_tree(cant_change, dst_scc)
                                     ->get_end(true);
         }
@@ -899,7 +901,7 @@ apply_false_true_clean(const twa_graph_ptr &sub_automaton, bool is_true,
         unsigned s_aut = (*init_states)[state];
         car_state src = { s_aut, state, perm_t() };
         unsigned src_state = car2num_local[src];
-        for (auto e : aut_->out(s_aut))
+        for (auto& e : aut_->out(s_aut))
         {
             auto col = is_true ^ !is_odd;
             if (((unsigned)col) > max_free_color)
@@ -943,7 +945,7 @@ apply_copy(const twa_graph_ptr &sub_automaton,
     auto cond_col = sub_automaton->acc().get_acceptance().used_sets();
     for (unsigned s = 0; s < sub_automaton->num_states(); ++s)
     {
-        for (auto e : sub_automaton->out(s))
+        for (auto& e : sub_automaton->out(s))
         {
             acc_cond::mark_t mark = { };
             int max_edge = -1;
@@ -1137,14 +1139,18 @@ apply_lar(const twa_graph_ptr &sub_automaton,
           unsigned max_states)
 {
     auto maps = get_mark_to_vector(sub_automaton);
-    // For each edge e of res_, we store the elements of the permutation
-    // that are not moved, and we respect the order.
-    std::map<unsigned, std::vector<unsigned>> edge_to_colors;
+    // For each edge e of res_ created by this function, we store the
+    // elements of the permutation that are not moved, and we respect
+    // the order.  Edges are created consecutively, so
+    // edge_to_colors[i] is related to edge first_edge + i.
+    bool track_colors = options.search_ex && options.use_last;
+    std::vector<std::vector<unsigned>> edge_to_colors;
+    unsigned first_edge = res_->edge_vector().size();
     unsigned nb_created_states = 0;
     auto state_2_car = state_2_car_scc(sub_automaton->num_states());
     std::vector<unsigned>* init_states = sub_automaton->
         get_named_prop<std::vector<unsigned>>("original-states");
-    std::deque<car_state> todo;
+    std::deque<std::pair<car_state, unsigned>> todo;
     auto get_state =
         [&](const car_state &s){
             auto it = car2num_local.find(s);
@@ -1158,7 +1164,7 @@ apply_lar(const twa_graph_ptr &sub_automaton,
                 car2num_local[s] = nb;
                 num2car.insert(num2car.begin() + nb, s);
 
-                todo.push_back(s);
+                todo.emplace_back(s, nb);
                 if (options.pretty_print)
                     names->push_back(s.to_string(algo));
                 return nb;
@@ -1195,10 +1201,10 @@ apply_lar(const twa_graph_ptr &sub_automaton,
     // the main loop
     while (!todo.empty())
     {
-        car_state current = todo.front();
+        car_state current = std::move(todo.front().first);
+        unsigned src_num = todo.front().second;
         todo.pop_front();
 
-        unsigned src_num = get_state(current);
         for (const auto &e : sub_automaton->out(current.state_scc))
         {
             perm_t new_perm = current.perm;
@@ -1223,14 +1229,11 @@ apply_lar(const twa_graph_ptr &sub_automaton,
                 assert(false);
             }
 
-            std::vector<unsigned> not_moved(new_perm.begin() + seen_nb,
-                                            new_perm.end());
-
             if (options.force_order)
             {
                 if (algo == CAR && seen_nb > 1)
                 {
-                    auto map = maps[e.dst];
+                    const auto& map = maps[e.dst];
                     acc_cond::mark_t first_vals(
                         new_perm.begin(), new_perm.begin() + seen_nb);
                     auto new_start = map.find(first_vals);
@@ -1242,7 +1245,7 @@ apply_lar(const twa_graph_ptr &sub_automaton,
                 else if ((algo == IAR_Streett || algo == IAR_Rabin)
                         && seen_nb > 1)
                 {
-                    auto map = iar_maps[e.dst];
+                    const auto& map = iar_maps[e.dst];
                     std::vector<unsigned> first_vals(
                             new_perm.begin(), new_perm.begin() + seen_nb);
                     std::sort(std::begin(first_vals), std::end(first_vals));
@@ -1301,10 +1304,16 @@ apply_lar(const twa_graph_ptr &sub_automaton,
                 }
             }
             auto new_e = res_->new_edge(src_num, dst_num, e.cond, { acc_col });
-            edge_to_colors.insert({new_e, not_moved});
+            if (track_colors)
+            {
+                assert(new_e == first_edge + edge_to_colors.size());
+                (void) new_e;
+                edge_to_colors.emplace_back(new_perm.begin() + seen_nb,
+                                            new_perm.end());
+            }
         }
     }
-    if (options.search_ex && options.use_last)
+    if (track_colors)
     {
         std::vector<unsigned> added_states;
         std::transform(car2num_local.begin(), car2num_local.end(),
@@ -1313,7 +1322,7 @@ apply_lar(const twa_graph_ptr &sub_automaton,
                            return pair.second;
                        });
         change_transitions_destination(
-            res_, added_states, edge_to_colors, state_2_car);
+            res_, added_states, edge_to_colors, first_edge, state_2_car);
     }
     auto leaving_edge =
         [&](unsigned d){
@@ -1643,7 +1652,7 @@ run()
     {
         unsigned original_state = num2car.at(state).state;
         auto state_scc = scc_.scc_of(original_state);
-        for (auto edge : aut_->out(original_state))
+        for (auto& edge : aut_->out(original_state))
         {
             if (scc_.scc_of(edge.dst) != state_scc)
             {
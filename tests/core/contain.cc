@@ -0,0 +1,69 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <vector>
+#include <spot/tl/contain.hh>
+#include <spot/tl/parse.hh>
+#include <spot/tl/print.hh>
+
+// Usage: contain L G1 G2...
+//
+// For each Gi, print whether L(L) is a subset of L(Gi), as answered
+// by contained(L, {G1, G2, ...}).  Exit with status 1 if any answer
+// differs from that of contained(L, Gi), computed either by a fresh
+// checker or by the checker already used for the vector query.
+int
+main(int argc, char** argv)
+{
+  if (argc < 2)
+    {
+      std::cerr << "usage: " << argv[0] << " L G1 G2...\n";
+      return 2;
+    }
+  spot::formula l = spot::parse_formula(argv[1]);
+  std::vector<spot::formula> gs;
+  for (int i = 2; i < argc; ++i)
+    gs.push_back(spot::parse_formula(argv[i]));
+
+  spot::language_containment_checker c;
+  std::vector<bool> res = c.contained(l, gs);
+  if (res.size() != gs.size())
+    {
+      std::cerr << "wrong result size\n";
+      return 1;
+    }
+
+  int exit_code = 0;
+  for (unsigned i = 0; i < gs.size(); ++i)
+    {
+      spot::language_containment_checker fresh;
+      bool one = fresh.contained(l, gs[i]);
+      bool same = c.contained(l, gs[i]);
+      std::cout << gs[i] << ": " << res[i] << '\n';
+      if (res[i] != one || res[i] != same)
+        {
+          std::cerr << "mismatch for " << gs[i] << ": vector=" << res[i]
+                    << " fresh=" << one << " same=" << same << '\n';
+          exit_code = 1;
+        }
+    }
+  return exit_code;
+}
@@ -115,7 +115,8 @@ main(int argc, char** argv)
         "Cou99", "Cou99(shy)",
         "CVWY90", "CVWY90(bsh=10M)", "CVWY90(repeated)",
         "SE05", "SE05(bsh=10M)", "SE05(repeated)",
-        "Tau03_opt", "GV04",
+        "Tau03_opt", "GV04", "GV04(hc=64)", "GV04(bsh=10M)",
+        "Cou99new(hc=64)", "Cou99abs(bsh=10M)", "Tau03(hc=64)",
       };
 
       for (auto& algo: algos)
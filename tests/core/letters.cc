@@ -0,0 +1,135 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <spot/twa/letters.hh>
+#include <spot/twa/bddprint.hh>
+
+int main()
+{
+  auto d = spot::make_bdd_dict();
+  auto aut = spot::make_twa_graph(d);
+  bdd a = bdd_ithvar(aut->register_ap("a"));
+  bdd b = bdd_ithvar(aut->register_ap("b"));
+  bdd c = bdd_ithvar(aut->register_ap("c"));
+
+  spot::letter_masks lm(aut->ap_vars());
+  std::cout << "letters: " << lm.num_letters() << '\n';
+
+  // Letters are ordered like the successive results of bdd_satoneset().
+  bdd all = bddtrue;
+  for (unsigned i = 0; all != bddfalse; ++i)
+    {
+      bdd one = bdd_satoneset(all, aut->ap_vars(), bddfalse);
+      all -= one;
+      if (one != lm.letter(i))
+        {
+          std::cout << "letter " << i << " is wrong\n";
+          return 1;
+        }
+      spot::bdd_print_formula(std::cout << i << ": ", d, one) << '\n';
+    }
+
+  bdd na = !a;
+  bdd nb = !b;
+  for (bdd f: {bdd(bddtrue), bdd(bddfalse), a, na, b, c, a & nb, a | c,
+               na & b & c, bdd_biimp(a, c)})
+    {
+      auto m = lm.as_mask(f);
+      spot::bdd_print_formula(std::cout, d, f)
+        << " [" << std::hex << m << std::dec << ']';
+      spot::letter_masks::for_each_letter(m, [](unsigned i)
+                                          {
+                                            std::cout << ' ' << i;
+                                          });
+      std::cout << '\n';
+      if (lm.as_bdd(m) != f)
+        {
+          std::cout << "round trip failed\n";
+          return 1;
+        }
+    }
+
+  // Operations on masks match operations on BDDs.
+  if (lm.as_bdd(lm.as_mask(a | b) & lm.as_mask(na | c))
+      != ((a | b) & (na | c))
+      || lm.as_bdd(lm.as_mask(a) | lm.as_mask(b & c)) != (a | (b & c))
+      || lm.as_bdd(~lm.as_mask(a & b)) != !(a & b))
+    return 1;
+
+  // With more atomic propositions, letter_sets should enumerate the
+  // letters of a label in the same order as bdd_satoneset().
+  bdd e = bdd_ithvar(aut->register_ap("e"));
+  bdd f = bdd_ithvar(aut->register_ap("f"));
+  bdd g = bdd_ithvar(aut->register_ap("g"));
+  bdd h = bdd_ithvar(aut->register_ap("h"));
+  bdd k = bdd_ithvar(aut->register_ap("k"));
+  bdd allap = aut->ap_vars();
+  spot::letter_sets ls(allap);
+  std::cout << "letters: " << ls.num_letters()
+            << " words: " << ls.num_words() << '\n';
+  bdd nh = !h;
+  for (bdd l: {bdd(bddtrue), bdd(bddfalse), a, k, a & nh, a | k,
+               bdd_biimp(b, h), (e & f) | (g & !c), bdd_xor(f, k) & na})
+    {
+      bdd rest = l;
+      unsigned count = 0;
+      bool ok = true;
+      spot::letter_sets::for_each_letter(ls.as_set(l), [&](unsigned i)
+        {
+          bdd one = bdd_satoneset(rest, allap, bddfalse);
+          rest -= one;
+          ok &= one == ls.letter(i);
+          ++count;
+        });
+      if (!ok || rest != bddfalse)
+        {
+          std::cout << "letter_sets failed\n";
+          return 1;
+        }
+      spot::bdd_print_formula(std::cout, d, l) << ": " << count << '\n';
+    }
+
+  // Partition of the alphabet induced by some labels.
+  aut->new_states(2);
+  aut->new_edge(0, 1, a);
+  aut->new_edge(0, 0, a & b);
+  aut->new_edge(1, 0, na | c);
+  aut->new_edge(1, 1, bddtrue);
+  aut->new_edge(1, 1, a);
+  auto& part = spot::alphabet_partition::of(aut);
+  for (unsigned i = 0; i < part.num_classes(); ++i)
+    spot::bdd_print_formula(std::cout << "class " << i << ": ", d,
+                            part.class_bdd(i)) << '\n';
+  for (auto& t: aut->edges())
+    {
+      unsigned num = aut->edge_number(t);
+      std::cout << "edge " << num << ':';
+      for (unsigned c: part.classes_of(num))
+        std::cout << ' ' << c;
+      std::cout << '\n';
+    }
+  if (spot::alphabet_partition::cached(aut) != &part)
+    return 1;
+  aut->edge_data(1).cond = b;
+  if (spot::alphabet_partition::cached(aut))
+    return 1;
+  return 0;
+}
@@ -0,0 +1,188 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <sstream>
+#include <spot/kripke/kripke.hh>
+#include <spot/misc/random.hh>
+#include <spot/tl/apcollect.hh>
+#include <spot/twa/twagraph.hh>
+#include <spot/twa/twaproduct.hh>
+#include <spot/twaalgos/multiprop.hh>
+#include <spot/twaalgos/randomgraph.hh>
+
+// A Kripke structure computed on the fly, which counts the calls to
+// succ_iter().  Its states are the integers from 0 to N-1.
+namespace
+{
+  struct int_state final: public spot::state
+  {
+    explicit int_state(unsigned n)
+      : n(n)
+    {
+    }
+
+    int compare(const spot::state* other) const override
+    {
+      unsigned o = static_cast<const int_state*>(other)->n;
+      return (n > o) - (n < o);
+    }
+
+    size_t hash() const override
+    {
+      return n;
+    }
+
+    int_state* clone() const override
+    {
+      return new int_state(n);
+    }
+
+    void destroy() const override
+    {
+      delete this;
+    }
+
+    unsigned n;
+  };
+
+  class int_succ_iterator final: public spot::kripke_succ_iterator
+  {
+  public:
+    int_succ_iterator(bdd cond, unsigned d1, unsigned d2)
+      : kripke_succ_iterator(cond), d_{d1, d2}
+    {
+    }
+
+    bool first() override
+    {
+      pos_ = 0;
+      return true;
+    }
+
+    bool next() override
+    {
+      return ++pos_ < 2;
+    }
+
+    bool done() const override
+    {
+      return pos_ >= 2;
+    }
+
+    const spot::state* dst() const override
+    {
+      return new int_state(d_[pos_]);
+    }
+
+  private:
+    unsigned d_[2];
+    unsigned pos_ = 0;
+  };
+
+  class int_kripke final: public spot::kripke
+  {
+  public:
+    int_kripke(const spot::bdd_dict_ptr& d, unsigned n,
+               spot::formula a, spot::formula b)
+      : kripke(d), n_(n)
+    {
+      a_ = bdd_ithvar(register_ap(a));
+      b_ = bdd_ithvar(register_ap(b));
+    }
+
+    const spot::state* get_init_state() const override
+    {
+      return new int_state(0);
+    }
+
+    spot::twa_succ_iterator*
+    succ_iter(const spot::state* s) const override
+    {
+      ++calls;
+      unsigned x = static_cast<const int_state*>(s)->n;
+      return new int_succ_iterator(state_condition(s),
+                                   (x + 1) % n_, (3 * x + 2) % n_);
+    }
+
+    bdd state_condition(const spot::state* s) const override
+    {
+      unsigned x = static_cast<const int_state*>(s)->n;
+      return ((x % 2 ? a_ : !a_) & (x % 3 ? b_ : !b_));
+    }
+
+    std::string format_state(const spot::state* s) const override
+    {
+      return "s" + std::to_string(static_cast<const int_state*>(s)->n);
+    }
+
+    mutable unsigned calls = 0;
+
+  private:
+    unsigned n_;
+    bdd a_;
+    bdd b_;
+  };
+}
+
+int
+main()
+{
+  auto dict = spot::make_bdd_dict();
+  spot::atomic_prop_set aps = spot::create_atomic_prop_set(2);
+  auto ap = aps.begin();
+  spot::formula a = *ap++;
+  spot::formula b = *ap;
+  auto model = std::make_shared<int_kripke>(dict, 50, a, b);
+
+  std::vector<spot::const_twa_ptr> props;
+  for (unsigned seed = 0; seed < 20; ++seed)
+    {
+      spot::srand(seed);
+      props.push_back(spot::random_graph(5, 0.5, &aps, dict, 1, 0.3));
+    }
+
+  int exit_code = 0;
+  model->calls = 0;
+  auto res = spot::multi_property_check(model, props, nullptr, true);
+  // The model has 50 reachable states.
+  std::cout << model->calls << " calls to succ_iter()\n";
+  if (model->calls != 50)
+    exit_code = 1;
+
+  for (unsigned i = 0; i < props.size(); ++i)
+    {
+      bool expected = !spot::otf_product(model, props[i])->is_empty();
+      std::cout << i << ": " << (res[i].non_empty ? "non-empty" : "empty")
+                << '\n';
+      if (res[i].non_empty != expected)
+        {
+          std::cout << i << ": wrong verdict\n";
+          exit_code = 1;
+        }
+      std::ostringstream os;
+      if (res[i].non_empty && (!res[i].run || !res[i].run->replay(os)))
+        {
+          std::cout << i << ": bad run\n" << os.str();
+          exit_code = 1;
+        }
+    }
+  return exit_code;
+}
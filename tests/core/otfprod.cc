@@ -0,0 +1,148 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <sstream>
+#include <spot/kripke/kripkegraph.hh>
+#include <spot/misc/random.hh>
+#include <spot/tl/apcollect.hh>
+#include <spot/twa/twaproduct.hh>
+#include <spot/twa/twagraph.hh>
+#include <spot/twaalgos/hoa.hh>
+#include <spot/twaalgos/randomgraph.hh>
+
+// Check that twa_succ_iterator::fill() returns the same successors
+// as first()/next() on all reachable states of AUT.
+static int
+check_fill(const char* name, const spot::const_twa_ptr& aut)
+{
+  spot::state_set seen;
+  std::vector<const spot::state*> todo;
+  std::vector<spot::twa_succ> buf;
+  const spot::state* init = aut->get_init_state();
+  seen.insert(init);
+  todo.push_back(init);
+  int res = 0;
+  while (!todo.empty())
+    {
+      const spot::state* s = todo.back();
+      todo.pop_back();
+      buf.clear();
+      auto* it = aut->succ_iter(s);
+      unsigned n = it->fill(buf);
+      unsigned i = 0;
+      for (auto succ: aut->succ(s))
+        {
+          const spot::state* d = succ->dst();
+          if (i >= n || d->compare(buf[i].dst) != 0
+              || succ->cond() != buf[i].cond || succ->acc() != buf[i].acc)
+            res = 1;
+          ++i;
+          if (seen.insert(d).second)
+            todo.push_back(d);
+          else
+            d->destroy();
+        }
+      if (i != n || n != buf.size())
+        res = 1;
+      for (auto& succ: buf)
+        succ.dst->destroy();
+      aut->release_iter(it);
+    }
+  for (auto s: seen)
+    s->destroy();
+  if (res)
+    std::cout << name << ": fill() differs from first()/next()\n";
+  return res;
+}
+
+// Compare the explicit product built by otf_product() with the
+// generic one.
+static int
+check(const char* name,
+      const spot::const_twa_ptr& left, const spot::const_twa_ptr& right)
+{
+  auto prod = spot::otf_product(left, right);
+  if (!std::dynamic_pointer_cast<spot::twa_product_explicit>(prod))
+    {
+      std::cout << name << ": not an explicit product\n";
+      return 1;
+    }
+  auto generic = std::make_shared<spot::twa_product>(left, right);
+
+  auto all = spot::twa::prop_set::all();
+  auto p1 = spot::make_twa_graph(prod, all);
+  auto p2 = spot::make_twa_graph(generic, all);
+  std::ostringstream s1;
+  std::ostringstream s2;
+  spot::print_hoa(s1, p1);
+  spot::print_hoa(s2, p2);
+  bool empty = prod->is_empty();
+  std::cout << name << ": " << p1->num_states() << " states, "
+            << p1->num_edges() << " edges, "
+            << (empty ? "empty" : "non-empty") << '\n';
+  if (s1.str() != s2.str() || empty != generic->is_empty())
+    {
+      std::cout << name << ": products differ\n";
+      return 1;
+    }
+  return (check_fill(name, left) | check_fill(name, right)
+          | check_fill(name, prod) | check_fill(name, generic));
+}
+
+int
+main()
+{
+  auto dict = spot::make_bdd_dict();
+  spot::atomic_prop_set aps = spot::create_atomic_prop_set(2);
+  const spot::atomic_prop_set* ap = &aps;
+  int res = 0;
+
+  for (unsigned seed = 0; seed < 5; ++seed)
+    {
+      spot::srand(seed);
+      auto a = spot::random_graph(20, 0.3, ap, dict, 2, 0.3);
+      auto b = spot::random_graph(10, 0.4, ap, dict, 1, 0.3);
+
+      // A random Kripke structure over the same propositions.
+      auto k = spot::make_kripke_graph(dict);
+      std::vector<bdd> vars;
+      for (auto& f: *ap)
+        vars.push_back(bdd_ithvar(k->register_ap(f)));
+      unsigned n = 15;
+      for (unsigned s = 0; s < n; ++s)
+        {
+          bdd cond = bddtrue;
+          for (bdd v: vars)
+            cond &= spot::drand() < 0.5 ? v : !v;
+          k->new_state(cond);
+        }
+      for (unsigned s = 0; s < n; ++s)
+        for (unsigned d = 0; d < n; ++d)
+          if (spot::drand() < 0.3)
+            k->new_edge(s, d);
+
+      std::string num = std::to_string(seed);
+      res |= check(("twa x twa " + num).c_str(), a, b);
+      res |= check(("kripke x twa " + num).c_str(), k, a);
+      res |= check(("twa x kripke " + num).c_str(), b, k);
+    }
+  return res;
+}
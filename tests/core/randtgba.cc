@@ -66,13 +66,18 @@ const char* default_algos[] = {
   "Cou99(poprem shy !group)",
   "Cou99(poprem shy group)",
   "Cou99new",
+  "Cou99new(hc=40)",
   "Cou99abs",
+  "Cou99abs(bsh=4K)",
   "CVWY90",
   "CVWY90(bsh=4K)",
   "GV04",
+  "GV04(hc=40)",
+  "GV04(bsh=4K)",
   "SE05",
   "SE05(bsh=4K)",
   "Tau03",
+  "Tau03(hc=40)",
   "Tau03_opt",
   "Tau03_opt(condstack)",
   "Tau03_opt(condstack ordering)",
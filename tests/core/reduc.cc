@@ -35,7 +35,7 @@
 static void
 syntax(char* prog)
 {
-  std::cerr << prog << " option formula1 (formula2)?\n";
+  std::cerr << prog << " [-f] [-h] [-l limit] option formula1 (formula2)?\n";
   exit(2);
 }
 
@@ -44,6 +44,7 @@ main(int argc, char** argv)
 {
   bool readfile = false;
   bool hidereduc = false;
+  unsigned cache_limit = 0;
   unsigned long sum_before = 0;
   unsigned long sum_after = 0;
   spot::tl_simplifier_options o(false, false, false, false, false);
@@ -65,6 +66,17 @@ main(int argc, char** argv)
       --argc;
     }
 
+  // Also simplify with caches bounded to LIMIT entries, and check
+  // that the results are the same.
+  if (!strncmp(argv[1], "-l", 3))
+    {
+      if (argc < 5)
+        syntax(argv[0]);
+      cache_limit = atoi(argv[2]);
+      argv += 2;
+      argc -= 2;
+    }
+
   switch (atoi(argv[1]))
     {
     case 0:
@@ -146,11 +158,18 @@ main(int argc, char** argv)
   }
 
   int exit_code = 0;
+  bool bounded_mismatch = false;
 
   {
     spot::tl_simplifier* simp = new spot::tl_simplifier(o);
     o.reduce_size_strictly = true;
     spot::tl_simplifier* simp_size = new spot::tl_simplifier(o);
+    spot::tl_simplifier* simp_bounded = nullptr;
+    if (cache_limit)
+      {
+        o.cache_size_limit = cache_limit;
+        simp_bounded = new spot::tl_simplifier(o);
+      }
 
     spot::formula f1 = nullptr;
     spot::formula f2 = nullptr;
@@ -218,6 +237,15 @@ main(int argc, char** argv)
 
       spot::formula input_f = f1;
       f1 = simp_size->simplify(input_f);
+      if (simp_bounded && simp_bounded->simplify(input_f) != f1)
+        {
+          std::cerr << "Bounded caches reduce `" << f1s_before
+                    << "' to `";
+          print_psl(std::cerr, simp_bounded->simplify(input_f))
+            << "' instead of `";
+          print_psl(std::cerr, f1) << "'.\n";
+          bounded_mismatch = true;
+        }
       if (!simp_size->are_equivalent(input_f, f1))
         {
           std::cerr << "Incorrect reduction from `" << f1s_before
@@ -296,6 +324,7 @@ main(int argc, char** argv)
     }
   end:
 
+    delete simp_bounded;
     delete simp_size;
     delete simp;
 
@@ -310,5 +339,7 @@ main(int argc, char** argv)
   }
 
   assert(spot::fnode::instances_check());
+  if (bounded_mismatch)
+    return 3;
   return exit_code;
 }
@@ -0,0 +1,105 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <string>
+#include <spot/tl/ltlf.hh>
+#include <spot/tl/relabel.hh>
+#include <spot/tl/print.hh>
+
+// Build a formula of the given depth in which each level uses the
+// previous one four times.  Its syntax tree is exponential in DEPTH,
+// but its DAG is linear.
+static spot::formula
+shared_formula(unsigned depth)
+{
+  spot::formula f =
+    spot::formula::U(spot::formula::ap("a"), spot::formula::ap("b"));
+  for (unsigned i = 0; i < depth; ++i)
+    {
+      std::string n = std::to_string(i);
+      spot::formula p = spot::formula::ap("p" + n);
+      spot::formula q = spot::formula::ap("q" + n);
+      spot::formula bse =
+        spot::formula::And({p, spot::formula::Not(q)});
+      f = spot::formula::Or({spot::formula::U(f, bse),
+                             spot::formula::And({f, spot::formula::X(f)}),
+                             spot::formula::G(spot::formula::Or({f, q}))});
+    }
+  return f;
+}
+
+static int
+check(unsigned depth, bool print)
+{
+  int res = 0;
+  spot::formula f = shared_formula(depth);
+  auto show = [&](const char* name, spot::formula g)
+    {
+      if (print)
+        std::cout << depth << ' ' << name << ": " << g << '\n';
+    };
+  auto roundtrip = [&](const char* name, spot::formula g,
+                       spot::relabeling_map& m)
+    {
+      if (spot::relabel_apply(g, &m) != f)
+        {
+          std::cerr << depth << ' ' << name
+                    << ": relabel_apply() does not restore the formula\n";
+          res = 1;
+        }
+    };
+
+  show("input", f);
+  {
+    spot::relabeling_map m;
+    spot::formula g = spot::relabel(f, spot::Pnn, &m);
+    show("relabel", g);
+    roundtrip("relabel", g, m);
+  }
+  {
+    spot::relabeling_map m;
+    spot::formula g = spot::relabel(f, spot::Abc, &m);
+    show("relabel Abc", g);
+    roundtrip("relabel Abc", g, m);
+  }
+  {
+    spot::relabeling_map m;
+    spot::formula g = spot::relabel_bse(f, spot::Pnn, &m);
+    show("relabel_bse", g);
+    roundtrip("relabel_bse", g, m);
+  }
+  show("from_ltlf", spot::from_ltlf(f));
+  show("from_ltlf !dead", spot::from_ltlf(f, "!dead"));
+  return res;
+}
+
+int
+main()
+{
+  int res = 0;
+  // Small depths are printed and compared with the expected output.
+  for (unsigned d = 0; d <= 2; ++d)
+    res |= check(d, true);
+  // The rewriting of deeper formulas would take forever without
+  // memoization.  Their syntax trees have about 4^40 nodes.
+  res |= check(40, false);
+  return res;
+}
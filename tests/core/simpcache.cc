@@ -0,0 +1,153 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <spot/tl/parse.hh>
+#include <spot/tl/print.hh>
+#include <spot/tl/simplify.hh>
+
+// Usage: simpcache FILE LIMIT
+//
+// Simplify each formula of FILE three times: with unbounded caches,
+// with caches bounded to LIMIT entries, and with three simplifiers
+// that take turns on a single shared cache bounded to LIMIT entries.
+// The shared cache is cleared, through one of its simplifiers, after
+// the first half of the formulas.  Finally, a new simplifier built
+// on the warm unbounded cache simplifies everything again.
+//
+// The simplified formulas are printed on stdout, and the statistics
+// of the bounded caches on stderr.  Exit with status 1 if the four
+// results of a formula differ, or if a cache does not behave as
+// expected.
+
+static unsigned
+simplified_entries(const spot::tl_simplifier& s)
+{
+  std::ostringstream os;
+  s.print_stats(os);
+  // The first line is "simplified formulae:    N entries..."
+  std::string str = os.str();
+  return std::stoul(str.substr(str.find(':') + 1));
+}
+
+int
+main(int argc, char** argv)
+{
+  if (argc != 3)
+    {
+      std::cerr << "usage: " << argv[0] << " FILE LIMIT\n";
+      return 2;
+    }
+  std::ifstream in(argv[1]);
+  if (!in)
+    {
+      std::cerr << "cannot open " << argv[1] << '\n';
+      return 2;
+    }
+
+  int exit_code = 0;
+  {
+    std::vector<spot::formula> input;
+    std::string line;
+    while (std::getline(in, line))
+      {
+        if (line.empty())
+          continue;
+        auto pf = spot::parse_infix_psl(line);
+        if (pf.format_errors(std::cerr))
+          return 2;
+        input.push_back(pf.f);
+      }
+
+    spot::tl_simplifier_options o;
+    spot::tl_simplifier unbounded(o);
+    o.cache_size_limit = atoi(argv[2]);
+    spot::tl_simplifier bounded(o);
+    spot::tl_simplifier shared0(o);
+    spot::tl_simplifier shared1(shared0.get_cache());
+    spot::tl_simplifier shared2(shared0.get_cache());
+    spot::tl_simplifier* shared[3] = { &shared0, &shared1, &shared2 };
+
+    std::vector<spot::formula> results;
+    unsigned n = input.size();
+    for (unsigned i = 0; i < n; ++i)
+      {
+        if (i == n / 2)
+          {
+            shared1.clear_caches();
+            if (shared0.get_cache() != shared1.get_cache()
+                || shared2.get_cache() != shared1.get_cache()
+                || simplified_entries(shared2) != 0)
+              {
+                std::cerr << "clear_caches() did not empty the shared cache\n";
+                exit_code = 1;
+              }
+          }
+        spot::formula r0 = unbounded.simplify(input[i]);
+        spot::formula r1 = bounded.simplify(input[i]);
+        spot::formula r2 = shared[i % 3]->simplify(input[i]);
+        if (r0 != r1 || r0 != r2)
+          {
+            std::cerr << "mismatch for " << input[i] << ": " << r0
+                      << " (unbounded), " << r1 << " (bounded), "
+                      << r2 << " (shared)\n";
+            exit_code = 1;
+          }
+        results.push_back(r0);
+        std::cout << r0 << '\n';
+      }
+
+    unsigned limit = o.cache_size_limit;
+    if (limit && (simplified_entries(bounded) > limit
+                  || simplified_entries(shared0) > limit))
+      {
+        std::cerr << "a bounded cache exceeds its limit\n";
+        exit_code = 1;
+      }
+
+    // A simplifier built on a warm cache only needs lookups.
+    unsigned before = simplified_entries(unbounded);
+    spot::tl_simplifier warm(unbounded.get_cache());
+    for (unsigned i = 0; i < n; ++i)
+      if (warm.simplify(input[i]) != results[i])
+        {
+          std::cerr << "mismatch for " << input[i] << " (warm cache)\n";
+          exit_code = 1;
+        }
+    if (simplified_entries(warm) != before)
+      {
+        std::cerr << "the warm cache was not reused\n";
+        exit_code = 1;
+      }
+
+    std::cerr << "bounded:\n";
+    bounded.print_stats(std::cerr);
+    std::cerr << "shared:\n";
+    shared0.print_stats(std::cerr);
+  }
+  assert(spot::fnode::instances_check());
+  return exit_code;
+}
@@ -0,0 +1,91 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <spot/tl/parse.hh>
+#include <spot/twa/twagraph.hh>
+#include <spot/twaalgos/contains.hh>
+#include <spot/twaalgos/swarm.hh>
+#include <spot/twaalgos/translate.hh>
+
+int
+main()
+{
+  const char* formulas[] = {
+    "a U b",
+    "GFa & GFb",
+    "a & !a",
+    "GFa & FG!a",
+    "G(a -> Fb) & Fa & G!b",
+    "(a U (b U c)) & G(c -> X!c) & GF(a | c)",
+  };
+  const char* algos[] = { "Cou99new", "Cou99abs(hc=40)", "GV04(bsh=1K)" };
+
+  std::vector<spot::emptiness_check_instantiator_ptr> insts;
+  for (auto algo: algos)
+    {
+      const char* err;
+      insts.push_back(spot::make_emptiness_check_instantiator(algo, &err));
+    }
+
+  int exit_code = 0;
+  for (auto str: formulas)
+    {
+      spot::formula f = spot::parse_formula(str);
+      spot::translator trans;
+      trans.set_type(spot::postprocessor::BA);
+      auto aut = trans.run(f);
+      bool expected = !aut->is_empty();
+
+      // Shuffling the successors should not change the automaton.
+      for (unsigned seed = 1; seed < 4; ++seed)
+        {
+          auto s = spot::make_twa_graph(spot::shuffle_successors(aut, seed),
+                                        spot::twa::prop_set::all());
+          if (s->num_states() != aut->num_states()
+              || s->num_edges() != aut->num_edges()
+              || !spot::are_equivalent(s, aut))
+            {
+              std::cout << str << ": seed " << seed
+                        << " changes the automaton\n";
+              exit_code = 1;
+            }
+        }
+
+      // All workers must agree, at least when they are safe.
+      for (unsigned i = 0; i < 9; ++i)
+        {
+          auto ec = spot::swarm_instantiate(aut, insts, i);
+          bool res = !!ec->check();
+          if (res != expected && (res || ec->safe()))
+            {
+              std::cout << str << ": worker " << i << " is wrong\n";
+              exit_code = 1;
+            }
+        }
+
+      auto r = spot::swarm_emptiness_check(aut, insts, 9);
+      std::cout << str << ": "
+                << (r.non_empty ? "non-empty" : "empty") << '\n';
+      if (r.worker < 0 || r.non_empty != expected)
+        exit_code = 1;
+    }
+  return exit_code;
+}
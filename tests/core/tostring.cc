@@ -22,6 +22,7 @@
 
 #include "config.h"
 #include <iostream>
+#include <sstream>
 #include <cassert>
 #include <spot/tl/parse.hh>
 #include <spot/tl/print.hh>
@@ -110,6 +111,44 @@ int main()
           std::cerr << f1s << " != " << f2s << '\n';
           return 1;
         }
+
+      // formula_print_buffer should agree with the str_*() functions.
+      typedef spot::formula_print_buffer pb;
+      std::ostringstream buffered;
+      std::string expected;
+      {
+        pb psl(buffered, pb::psl);
+        pb sere(buffered, pb::sere, true);
+        pb utf8(buffered, pb::utf8_psl);
+        pb latex(buffered, pb::latex_sere);
+        pb sclatex(buffered, pb::sclatex_psl, true);
+        psl << f1 << '\n';
+        sere << f1 << '\n';
+        utf8 << f1 << '\n';
+        latex << f1 << '\n';
+        sclatex << f1 << '\n';
+        psl.flush();
+        sere.flush();
+        utf8.flush();
+        latex.flush();
+        sclatex.flush();
+        expected = f1s + '\n' + spot::str_sere(f1, true) + '\n'
+          + spot::str_utf8_psl(f1) + '\n' + spot::str_latex_sere(f1) + '\n'
+          + spot::str_sclatex_psl(f1, true) + '\n';
+        if (f1.is_ltl_formula())
+          {
+            pb(buffered, pb::spin_ltl) << f1;
+            pb(buffered, pb::wring_ltl) << f1;
+            pb(buffered, pb::lbt_ltl) << f1;
+            expected += spot::str_spin_ltl(f1) + spot::str_wring_ltl(f1)
+              + spot::str_lbt_ltl(f1);
+          }
+      }
+      if (buffered.str() != expected)
+        {
+          std::cerr << buffered.str() << "!=\n" << expected;
+          return 1;
+        }
     }
     assert(spot::fnode::instances_check());
   }
@@ -0,0 +1,88 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <vector>
+#include <spot/misc/treedb.hh>
+
+static int
+check(unsigned size)
+{
+  spot::int_vector_tree_db db(size);
+  std::vector<std::vector<int>> vecs;
+  // Vectors that differ in few positions, with some duplicates and
+  // negative values.
+  std::vector<int> v(size);
+  for (unsigned i = 0; i < size; ++i)
+    v[i] = i - 2;
+  for (unsigned n = 0; n < 200; ++n)
+    {
+      if (size)
+        v[(n * 7) % size] = (n % 13) - 5;
+      vecs.push_back(v);
+    }
+
+  int res = 0;
+  std::vector<unsigned> idx;
+  unsigned expected_next = 0;
+  for (auto& vec: vecs)
+    {
+      unsigned i = db.insert(vec.data());
+      if (i > expected_next)
+        {
+          std::cout << "size " << size << ": index " << i
+                    << " should be at most " << expected_next << '\n';
+          res = 1;
+        }
+      else if (i == expected_next)
+        ++expected_next;
+      idx.push_back(i);
+    }
+  std::vector<int> out(size);
+  for (unsigned n = 0; n < vecs.size(); ++n)
+    {
+      db.get(idx[n], out.data());
+      if (out != vecs[n])
+        {
+          std::cout << "size " << size << ": vector " << n
+                    << " differs\n";
+          res = 1;
+        }
+      for (unsigned m = 0; m < n; ++m)
+        if ((idx[m] == idx[n]) != (vecs[m] == vecs[n]))
+          {
+            std::cout << "size " << size << ": vectors " << m
+                      << " and " << n << " have wrong indices\n";
+            res = 1;
+          }
+    }
+  std::cout << "size " << size << ": " << db.count() << " vectors, "
+            << db.pairs() << " pairs\n";
+  return res;
+}
+
+int
+main()
+{
+  int res = 0;
+  for (unsigned size: {0, 1, 2, 3, 5, 8, 17, 100})
+    res |= check(size);
+  return res;
+}
@@ -0,0 +1,155 @@
+// -*- coding: utf-8 -*-
+// Copyright (C) 2020 Laboratoire de Recherche et Développement
+// de l'Epita (LRDE).
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "config.h"
+#include <iostream>
+#include <spot/kripke/kripkegraph.hh>
+#include <spot/misc/random.hh>
+#include <spot/tl/apcollect.hh>
+#include <spot/twa/twahandle.hh>
+#include <spot/twa/twaproduct.hh>
+#include <spot/twa/twagraph.hh>
+#include <spot/twaalgos/couvreurnew.hh>
+#include <spot/twaalgos/randomgraph.hh>
+
+// Explore all states of AUT, and count its edges.
+static unsigned
+count_edges(const spot::const_handle_twa_ptr& aut)
+{
+  std::vector<bool> seen;
+  std::vector<spot::state_handle> todo;
+  std::vector<spot::handle_succ> buf;
+  unsigned edges = 0;
+  spot::state_handle init = aut->get_init_state();
+  seen.resize(aut->num_states());
+  seen[init] = true;
+  todo.push_back(init);
+  while (!todo.empty())
+    {
+      spot::state_handle s = todo.back();
+      todo.pop_back();
+      buf.clear();
+      edges += aut->succ(s, buf);
+      seen.resize(aut->num_states());
+      for (auto& succ: buf)
+        if (!seen[succ.dst])
+          {
+            seen[succ.dst] = true;
+            todo.push_back(succ.dst);
+          }
+    }
+  return edges;
+}
+
+// Compare the product of handle_twa with twa_product.
+static int
+check(const char* name,
+      const spot::const_twa_ptr& left, const spot::const_twa_ptr& right)
+{
+  auto prod = std::make_shared<spot::twa_product>(left, right);
+  auto all = spot::twa::prop_set::all();
+  auto expected = spot::make_twa_graph(prod, all);
+  bool empty = prod->is_empty();
+
+  int res = 0;
+  auto check_one = [&](const char* kind, spot::const_handle_twa_ptr h)
+    {
+      bool e = spot::couvreur99_new_is_empty(h);
+      unsigned edges = count_edges(h);
+      if (e != empty || h->num_states() != expected->num_states()
+          || edges != expected->num_edges()
+          || h->acc().get_acceptance() != prod->acc().get_acceptance())
+        {
+          std::cout << name << ": " << kind << " handles differ\n";
+          res = 1;
+        }
+      // The successors of the initial state should come in the same
+      // order as in twa_product, and be printed the same way.
+      std::vector<spot::handle_succ> buf;
+      spot::state_handle hinit = h->get_init_state();
+      h->succ(hinit, buf);
+      const spot::state* init = prod->get_init_state();
+      bool same = h->format_state(hinit) == prod->format_state(init);
+      unsigned i = 0;
+      spot::twa_succ_iterator* it = prod->succ_iter(init);
+      for (it->first(); !it->done(); it->next(), ++i)
+        {
+          const spot::state* dst = it->dst();
+          same &= i < buf.size() && buf[i].cond == it->cond()
+            && buf[i].acc == it->acc()
+            && h->format_state(buf[i].dst) == prod->format_state(dst);
+          dst->destroy();
+        }
+      prod->release_iter(it);
+      init->destroy();
+      if (!same || i != buf.size())
+        {
+          std::cout << name << ": " << kind << " successors differ\n";
+          res = 1;
+        }
+    };
+  check_one("product", spot::handle_product(spot::make_handle_twa(left),
+                                            spot::make_handle_twa(right)));
+  check_one("generic", spot::make_handle_twa(prod));
+
+  std::cout << name << ": " << expected->num_states() << " states, "
+            << expected->num_edges() << " edges, "
+            << (empty ? "empty" : "non-empty") << '\n';
+  return res;
+}
+
+int
+main()
+{
+  auto dict = spot::make_bdd_dict();
+  spot::atomic_prop_set aps = spot::create_atomic_prop_set(2);
+  const spot::atomic_prop_set* ap = &aps;
+  int res = 0;
+
+  for (unsigned seed = 0; seed < 5; ++seed)
+    {
+      spot::srand(seed);
+      auto a = spot::random_graph(20, 0.15, ap, dict, 3, 0.01);
+      auto b = spot::random_graph(10, 0.3, ap, dict, 1, 0.05);
+
+      // A random Kripke structure over the same propositions.
+      auto k = spot::make_kripke_graph(dict);
+      std::vector<bdd> vars;
+      for (auto& f: *ap)
+        vars.push_back(bdd_ithvar(k->register_ap(f)));
+      unsigned n = 15;
+      for (unsigned s = 0; s < n; ++s)
+        {
+          bdd cond = bddtrue;
+          for (bdd v: vars)
+            cond &= spot::drand() < 0.5 ? v : !v;
+          k->new_state(cond);
+        }
+      for (unsigned s = 0; s < n; ++s)
+        for (unsigned d = 0; d < n; ++d)
+          if (spot::drand() < 0.3)
+            k->new_edge(s, d);
+
+      std::string num = std::to_string(seed);
+      res |= check(("twa x twa " + num).c_str(), a, b);
+      res |= check(("kripke x twa " + num).c_str(), k, a);
+      res |= check(("twa x kripke " + num).c_str(), a, k);
+    }
+  return res;
+}
@@ -31,6 +31,10 @@
 #include <cstring>
 #include <spot/kripke/kripkegraph.hh>
 #include <spot/twaalgos/hoa.hh>
+#include <spot/twaalgos/couvreurnew.hh>
+#include <spot/twaalgos/multiprop.hh>
+#include <spot/twaalgos/stutter.hh>
+#include <spot/twaalgos/swarm.hh>
 
 static void
 syntax(char* prog)
@@ -40,9 +44,15 @@ syntax(char* prog)
   if (slash && (strncmp(slash + 1, "lt-", 3) == 0))
     prog = slash + 4;
 
-  std::cerr << "usage: " << prog << " [options] model formula\n\
+  std::cerr << "usage: " << prog << " [options] model formula...\n\
+\n\
+With several formulas, the model is explored once, and each formula\n\
+is checked against it (the -g, -H, -p, and -s options are not\n\
+supported).\n\
 \n\
 Options:\n\
+  -cFILE load the state-space from the cache FILE, creating it if\n\
+          needed (the -p, -t, -z, and -Z options are ignored)\n\
   -dDEAD use DEAD as property for marking DEAD states\n\
           (by default DEAD = true)\n\
   -e[ALGO]  run emptiness check, expect an accepting run\n\
@@ -53,6 +63,12 @@ Options:\n\
   -gm    output the model state-space in dot format\n\
   -gK    output the model state-space in Kripke format\n\
   -gp    output the product state-space in dot format\n\
+  -H     check emptiness on state handles (Cou99 without run, the\n\
+          -C, -p, -s, -t, -z, and -Z options are ignored)\n\
+  -p     use partial-order reduction (formula must be stutter-invariant)\n\
+  -sN    run a swarm of N diversified emptiness checks in parallel, cycling\n\
+          over the algorithms of all -e/-E options\n\
+  -t     store states in a tree database\n\
   -T     time the different phases of the execution\n\
   -z     compress states to handle larger models\n\
   -Z     compress states (faster) assuming all values in [0 .. 2^28-1]\n\
@@ -73,9 +89,14 @@ checked_main(int argc, char **argv)
   bool expect_counter_example = false;
   bool deterministic = false;
   char *dead = nullptr;
+  const char* cache = nullptr;
   int compress_states = 0;
+  bool por = false;
+  unsigned swarm_workers = 0;
+  bool use_handles = false;
 
   const char* echeck_algo = "Cou99";
+  std::vector<const char*> echeck_algos;
 
   int dest = 1;
   int n = argc;
@@ -86,6 +107,9 @@ checked_main(int argc, char **argv)
         {
           switch (*++opt)
             {
+            case 'c':
+              cache = opt + 1;
+              break;
             case 'C':
               accepting_run = true;
               break;
@@ -101,6 +125,7 @@ checked_main(int argc, char **argv)
                 echeck_algo = opt + 1;
                 if (!*echeck_algo)
                   echeck_algo = "Cou99";
+                echeck_algos.push_back(echeck_algo);
 
                 expect_counter_example = (*opt == 'e');
                 output = EmptinessCheck;
@@ -125,6 +150,24 @@ checked_main(int argc, char **argv)
                   goto error;
                 }
               break;
+            case 'H':
+              use_handles = true;
+              break;
+            case 'p':
+              por = true;
+              break;
+            case 's':
+              {
+                char* end;
+                long w = strtol(opt + 1, &end, 10);
+                if (end == opt + 1 || *end || w <= 0)
+                  goto error;
+                swarm_workers = w;
+                break;
+              }
+            case 't':
+              compress_states = 3;
+              break;
             case 'T':
               use_timer = true;
               break;
@@ -147,7 +190,7 @@ checked_main(int argc, char **argv)
         }
     }
 
-  if (argc != 3)
+  if (argc < 3)
     syntax(argv[0]);
 
   spot::default_environment& env =
@@ -160,6 +203,7 @@ checked_main(int argc, char **argv)
   spot::const_twa_ptr prop = nullptr;
   spot::const_twa_ptr product = nullptr;
   spot::emptiness_check_instantiator_ptr echeck_inst = nullptr;
+  std::vector<spot::emptiness_check_instantiator_ptr> swarm_insts;
   int exit_code = 0;
   spot::postprocessor post;
   spot::formula deadf = nullptr;
@@ -189,6 +233,89 @@ checked_main(int argc, char **argv)
           exit_code = 1;
           goto safe_exit;
         }
+      if (swarm_workers)
+        {
+          if (echeck_algos.empty())
+            echeck_algos.push_back(echeck_algo);
+          for (const char* algo: echeck_algos)
+            {
+              auto inst = spot::make_emptiness_check_instantiator(algo, &err);
+              if (!inst)
+                {
+                  std::cerr << "Failed to parse argument of -e/-E near `"
+                            << err <<  "'\n";
+                  exit_code = 1;
+                  goto safe_exit;
+                }
+              swarm_insts.push_back(inst);
+            }
+        }
+    }
+
+  if (argc > 3)
+    {
+      if (output != EmptinessCheck || use_handles || por || swarm_workers)
+        {
+          std::cerr << "Options -g, -H, -p, and -s need a single formula.\n";
+          exit_code = 1;
+          goto safe_exit;
+        }
+
+      std::vector<spot::const_twa_ptr> props;
+      tm.start("translating formulas");
+      {
+        spot::translator trans(dict);
+        if (deterministic)
+          trans.set_pref(spot::postprocessor::Deterministic);
+        for (int i = 2; i < argc; ++i)
+          {
+            auto pf = spot::parse_infix_psl(argv[i], env, false);
+            exit_code = pf.format_errors(std::cerr);
+            if (exit_code)
+              break;
+            atomic_prop_collect(pf.f, &ap);
+            props.push_back(trans.run(pf.f));
+          }
+      }
+      tm.stop("translating formulas");
+      if (exit_code)
+        goto safe_exit;
+
+      tm.start("loading ltsmin model");
+      try
+        {
+          if (cache)
+            model = spot::ltsmin_model::load(argv[1])
+              .kripke_cached(cache, &ap, dict, deadf);
+          else
+            model = spot::ltsmin_model::load(argv[1]).kripke(&ap, dict, deadf,
+                                                             compress_states);
+        }
+      catch (const std::runtime_error& e)
+        {
+          std::cerr << e.what() << '\n';
+          exit_code = 1;
+        }
+      tm.stop("loading ltsmin model");
+      if (exit_code)
+        goto safe_exit;
+
+      tm.start("checking formulas");
+      auto res = spot::multi_property_check(model, props, echeck_inst,
+                                            accepting_run);
+      tm.stop("checking formulas");
+      for (int i = 2; i < argc; ++i)
+        {
+          auto& r = res[i - 2];
+          std::cout << argv[i] << ": "
+                    << (r.non_empty ? "an accepting run exists"
+                        : "no accepting run found") << std::endl;
+          if (r.run)
+            std::cout << *r.run->reduce();
+          if (r.non_empty != expect_counter_example)
+            exit_code = 1;
+        }
+      goto safe_exit;
     }
 
   tm.start("parsing formula");
@@ -208,19 +335,67 @@ checked_main(int argc, char **argv)
     if (deterministic)
       trans.set_pref(spot::postprocessor::Deterministic);
 
-    prop = trans.run(&f);
+    auto aut = trans.run(&f);
+    prop = aut;
+    if (por && !spot::check_stutter_invariance(aut, f).is_true())
+      {
+        std::cerr << "Partial-order reduction (-p) requires a "
+                  << "stutter-invariant formula.\n";
+        exit_code = 1;
+      }
   }
   tm.stop("translating formula");
 
+  if (exit_code)
+    goto safe_exit;
+
   atomic_prop_collect(f, &ap);
 
+  if (use_handles && output == EmptinessCheck)
+    {
+      tm.start("loading ltsmin model");
+      spot::const_handle_twa_ptr hmodel = nullptr;
+      try
+        {
+          hmodel = spot::ltsmin_model::load(argv[1]).handle_kripke(&ap, dict,
+                                                                   deadf);
+        }
+      catch (const std::runtime_error& e)
+        {
+          std::cerr << e.what() << '\n';
+          exit_code = 1;
+        }
+      tm.stop("loading ltsmin model");
+      if (exit_code)
+        goto safe_exit;
+
+      auto hproduct = spot::handle_product(hmodel,
+                                           spot::make_handle_twa(prop));
+      tm.start("running emptiness check");
+      bool empty = spot::couvreur99_new_is_empty(hproduct);
+      tm.stop("running emptiness check");
+      std::cout << hproduct->num_states() << " states visited\n";
+      if (empty)
+        std::cout << "no accepting run found" << std::endl;
+      else
+        std::cout << "an accepting run exists" << std::endl;
+      if (expect_counter_example == empty)
+        exit_code = 1;
+      goto safe_exit;
+    }
+
   if (output != DotFormula)
     {
       tm.start("loading ltsmin model");
       try
         {
-          model = spot::ltsmin_model::load(argv[1]).kripke(&ap, dict, deadf,
-                                                           compress_states);
+          if (cache)
+            model = spot::ltsmin_model::load(argv[1])
+              .kripke_cached(cache, &ap, dict, deadf);
+          else
+            model = spot::ltsmin_model::load(argv[1]).kripke(&ap, dict, deadf,
+                                                             compress_states,
+                                                             por);
         }
       catch (const std::runtime_error& e)
         {
@@ -270,6 +445,62 @@ checked_main(int argc, char **argv)
 
   assert(echeck_inst);
 
+  if (swarm_workers)
+    {
+      tm.start("running swarm emptiness check");
+      spot::swarm_result res;
+      try
+        {
+          res = spot::swarm_emptiness_check(product, swarm_insts,
+                                            swarm_workers);
+        }
+      catch (const std::runtime_error& e)
+        {
+          std::cerr << e.what() << '\n';
+          exit_code = 2;
+          goto safe_exit;
+        }
+      tm.stop("running swarm emptiness check");
+
+      if (expect_counter_example != res.non_empty
+          && (!expect_counter_example || res.worker >= 0))
+        exit_code = 1;
+
+      if (res.worker < 0)
+        {
+          std::cout << "no accepting run found by the swarm" << std::endl;
+        }
+      else if (!res.non_empty)
+        {
+          std::cout << "worker " << res.worker
+                    << " found no accepting run" << std::endl;
+        }
+      else
+        {
+          std::cout << "worker " << res.worker
+                    << " found an accepting run" << std::endl;
+          if (accepting_run)
+            {
+              // Replay the search of the winner to obtain its run.
+              tm.start("computing accepting run");
+              auto ec = spot::swarm_instantiate(product, swarm_insts,
+                                                res.worker);
+              spot::twa_run_ptr run;
+              if (auto ecr = ec->check())
+                run = ecr->accepting_run();
+              tm.stop("computing accepting run");
+              if (run)
+                {
+                  tm.start("reducing accepting run");
+                  run = run->reduce();
+                  tm.stop("reducing accepting run");
+                  std::cout << *run;
+                }
+            }
+        }
+      goto safe_exit;
+    }
+
   {
     auto ec = echeck_inst->instantiate(product);
     bool search_many = echeck_inst->options().get("repeated");